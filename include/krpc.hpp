@@ -3,9 +3,11 @@
 #include <string>
 
 #include "krpc/client.hpp"  // IWYU pragma: export
+#include "krpc/connection.hpp"  // IWYU pragma: export
 #include "krpc/error.hpp"  // IWYU pragma: export
 #include "krpc/krpc.pb.hpp"  // IWYU pragma: export
 #include "krpc/object.hpp"  // IWYU pragma: export
+#include "krpc/stream_manager.hpp"
 
 namespace krpc {
 
@@ -18,4 +20,25 @@ namespace krpc {
 Client connect(const std::string& name = "", const std::string& address = "127.0.0.1",
                unsigned int rpc_port = 50000, unsigned int stream_port = 50001);
 
+/**
+ * Connect to a kRPC server, and set options on the sockets of the connections once the
+ * connections have been made.
+ */
+Client connect(const std::string& name, const std::string& address, unsigned int rpc_port,
+               unsigned int stream_port, const ConnectionOptions& options);
+
+inline Client connect(const std::string& name, const std::string& address,
+                      unsigned int rpc_port, unsigned int stream_port,
+                      const ConnectionOptions& options) {
+  Client client = connect(name, address, rpc_port, stream_port);
+  client.set_connection_options(options);
+  return client;
+}
+
+inline void Client::set_connection_options(const ConnectionOptions& options) {
+  rpc_connection->set_options(options);
+  if (stream_manager && stream_manager->get_connection())
+    stream_manager->get_connection()->set_options(options);
+}
+
 }  // namespace krpc
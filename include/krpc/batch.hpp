@@ -0,0 +1,148 @@
+#pragma once
+
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <future>  // NOLINT(build/c++11)
+#include <memory>
+#include <mutex>  // NOLINT(build/c++11)
+#include <string>
+#include <vector>
+
+#include "krpc/client.hpp"
+#include "krpc/connection.hpp"
+#include "krpc/decoder.hpp"
+#include "krpc/encoder.hpp"
+#include "krpc/error.hpp"
+#include "krpc/krpc.pb.hpp"
+#include "krpc/message_parser.hpp"
+
+namespace krpc {
+
+/**
+ * A batch of procedure calls, sent to the server in a single request.
+ * Calls are built using the *_call() methods of the generated services, and
+ * their results are returned as futures that become ready when send() completes.
+ */
+class Batch {
+ public:
+  explicit Batch(Client * client);
+  /** Add a call to the batch. Returns a future for its decoded return value. */
+  template <typename T> std::future<T> add(const schema::ProcedureCall& call);
+  /** Add a call that has no return value, or whose return value is not needed. */
+  std::future<void> add(const schema::ProcedureCall& call);
+  /** The number of calls that have been added, but not yet sent. */
+  size_t size() const;
+  bool empty() const;
+  /**
+   * Send the calls to the server and wait for the results. Errors raised by
+   * individual calls are stored in their futures. The batch is empty afterwards,
+   * and can be reused.
+   */
+  void send();
+  /** Counters for the message that responses are parsed into. */
+  ParseStats parse_stats() const;
+
+ private:
+  typedef std::function<void(const schema::ProcedureResult*, const std::exception_ptr&)> Handler;
+  template <typename T> static void set_value(std::promise<T>& promise, const std::string& data,
+                                              Client * client);
+  static void set_value(std::promise<void>& promise, const std::string& data, Client * client);
+  template <typename T> std::future<T> add_call(const schema::ProcedureCall& call);
+  Client * client;
+  schema::Request request;
+  std::vector<Handler> handlers;
+  /** Parses responses, reusing memory when the batch is reused */
+  std::unique_ptr<MessageParser<schema::Response>> responses;
+};
+
+inline Batch Client::batch() {
+  return Batch(this);
+}
+
+inline Batch::Batch(Client * client) :
+  client(client), responses(new MessageParser<schema::Response>()) {
+}
+
+template <typename T> inline std::future<T> Batch::add(const schema::ProcedureCall& call) {
+  return add_call<T>(call);
+}
+
+inline std::future<void> Batch::add(const schema::ProcedureCall& call) {
+  return add_call<void>(call);
+}
+
+inline size_t Batch::size() const {
+  return handlers.size();
+}
+
+inline bool Batch::empty() const {
+  return handlers.empty();
+}
+
+inline void Batch::send() {
+  if (handlers.empty())
+    return;
+  std::vector<Handler> pending;
+  pending.swap(handlers);
+  schema::Request sent;
+  sent.Swap(&request);
+  try {
+    std::string data;
+    {
+      std::lock_guard<std::mutex> guard(*client->lock);
+      client->rpc_connection->send(encoder::encode_message_with_size(sent));
+      data = client->rpc_connection->receive_message();
+    }
+    const schema::Response& response = responses->parse(data);
+    if (response.has_error())
+      client->throw_exception(response.error());
+    if (response.results_size() != static_cast<int>(pending.size()))
+      throw RPCError("Batch request returned an unexpected number of results");
+    for (size_t i = 0; i < pending.size(); i++)
+      pending[i](&response.results(static_cast<int>(i)), std::exception_ptr());
+  } catch (...) {
+    std::exception_ptr exception = std::current_exception();
+    for (auto& handler : pending)
+      handler(nullptr, exception);
+    throw;
+  }
+}
+
+inline ParseStats Batch::parse_stats() const {
+  return responses->stats();
+}
+
+template <typename T> inline void Batch::set_value(
+  std::promise<T>& promise, const std::string& data, Client * client) {
+  T value;
+  decoder::decode(value, data, client);
+  promise.set_value(value);
+}
+
+inline void Batch::set_value(std::promise<void>& promise, const std::string&, Client *) {
+  promise.set_value();
+}
+
+template <typename T> inline std::future<T> Batch::add_call(const schema::ProcedureCall& call) {
+  auto promise = std::make_shared<std::promise<T>>();
+  Client * client = this->client;
+  handlers.push_back(
+    [promise, client] (const schema::ProcedureResult* result, const std::exception_ptr& exception) {
+      if (!result) {
+        promise->set_exception(exception);
+        return;
+      }
+      try {
+        if (result->has_error())
+          client->throw_exception(result->error());
+        set_value(*promise, result->value(), client);
+      } catch (...) {
+        promise->set_exception(std::current_exception());
+      }
+    });
+  request.add_calls()->CopyFrom(call);
+  return promise->get_future();
+}
+
+}  // namespace krpc
@@ -0,0 +1,182 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>  // NOLINT(build/c++11)
+#include <cstddef>
+#include <cstdio>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace krpc {
+
+/** The result of running a benchmark. Times are in nanoseconds. */
+struct BenchmarkResult {
+  BenchmarkResult() : iterations(0), time(0), items_per_second(0),
+                      p50(0), p90(0), p99(0), max(0) {}
+  std::string name;
+  size_t iterations;
+  /** Mean time per iteration */
+  double time;
+  /** Items processed per second, if the benchmark counts items */
+  double items_per_second;
+  /** Percentiles of the time taken by each iteration, if the benchmark measures latency */
+  double p50;
+  double p90;
+  double p99;
+  double max;
+};
+
+/**
+ * Prevent the compiler from optimizing away the computation of a value that is
+ * otherwise unused by a benchmark.
+ */
+template <typename T> void do_not_optimize(const T& value);
+
+/**
+ * Runs benchmarks and collects their results, in the style of Google Benchmark.
+ * run() repeats an operation in growing batches until the batch takes at least the
+ * minimum time, so fast operations are timed without the overhead of reading the clock
+ * each iteration. latency() instead times each iteration, to give the distribution of
+ * the time taken, which matters for operations that wait on a server.
+ */
+class Benchmarks {
+ public:
+  typedef std::function<void()> Operation;
+  /** Create a set of benchmarks, each run for at least the given number of seconds. */
+  explicit Benchmarks(double min_time = 0.5);
+  /** Run an operation that processes the given number of items each time it is called. */
+  const BenchmarkResult& run(const std::string& name, const Operation& operation,
+                             size_t items = 1);
+  /** Time each of the given number of calls to an operation. */
+  const BenchmarkResult& latency(const std::string& name, const Operation& operation,
+                                 size_t iterations);
+  /** Add a result measured by the caller. */
+  const BenchmarkResult& add(const BenchmarkResult& result);
+  double min_time() const;
+  const std::vector<BenchmarkResult>& results() const;
+  /** Write the results as a table. */
+  void report(std::ostream& stream) const;
+
+ private:
+  typedef std::chrono::steady_clock Clock;
+  static double elapsed(Clock::time_point start, Clock::time_point end);
+  static double percentile(const std::vector<double>& sorted, double fraction);
+  double minimum;
+  std::vector<BenchmarkResult> result_list;
+};
+
+template <typename T> inline void do_not_optimize(const T& value) {
+#ifdef _MSC_VER
+  static const volatile void * sink;
+  sink = &value;
+  _ReadWriteBarrier();
+#else
+  asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+
+inline Benchmarks::Benchmarks(double min_time) : minimum(min_time) {}
+
+inline const BenchmarkResult& Benchmarks::run(
+  const std::string& name, const Operation& operation, size_t items) {
+  // Warm up caches and any lazily initialized state
+  operation();
+  size_t iterations = 1;
+  double time = 0;
+  while (true) {
+    auto start = Clock::now();
+    for (size_t i = 0; i < iterations; i++)
+      operation();
+    time = elapsed(start, Clock::now());
+    if (time >= minimum * 1e9 || iterations >= (size_t(1) << 40))
+      break;
+    // Aim past the minimum time, but grow by at most 10x at a time
+    double scale = time > 0 ? 1.4 * minimum * 1e9 / time : 10;
+    iterations = static_cast<size_t>(iterations * std::min(std::max(scale, 2.0), 10.0));
+  }
+  BenchmarkResult result;
+  result.name = name;
+  result.iterations = iterations;
+  result.time = time / iterations;
+  result.items_per_second = items * iterations / (time / 1e9);
+  return add(result);
+}
+
+inline const BenchmarkResult& Benchmarks::latency(
+  const std::string& name, const Operation& operation, size_t iterations) {
+  operation();
+  std::vector<double> times(iterations);
+  double total = 0;
+  for (size_t i = 0; i < iterations; i++) {
+    auto start = Clock::now();
+    operation();
+    times[i] = elapsed(start, Clock::now());
+    total += times[i];
+  }
+  std::sort(times.begin(), times.end());
+  BenchmarkResult result;
+  result.name = name;
+  result.iterations = iterations;
+  if (iterations > 0) {
+    result.time = total / iterations;
+    result.items_per_second = iterations / (total / 1e9);
+    result.p50 = percentile(times, 0.5);
+    result.p90 = percentile(times, 0.9);
+    result.p99 = percentile(times, 0.99);
+    result.max = times.back();
+  }
+  return add(result);
+}
+
+inline const BenchmarkResult& Benchmarks::add(const BenchmarkResult& result) {
+  result_list.push_back(result);
+  return result_list.back();
+}
+
+inline double Benchmarks::min_time() const {
+  return minimum;
+}
+
+inline const std::vector<BenchmarkResult>& Benchmarks::results() const {
+  return result_list;
+}
+
+inline void Benchmarks::report(std::ostream& stream) const {
+  size_t width = 9;
+  for (auto& result : result_list)
+    width = std::max(width, result.name.size());
+  char line[256];
+  std::snprintf(line, sizeof(line), "%-*s %13s %12s %13s %11s %11s %11s %11s\n",
+                static_cast<int>(width), "Benchmark", "Time", "Iterations", "Items/s",
+                "p50", "p90", "p99", "Max");
+  stream << line << std::string(width + 89, '-') << std::endl;
+  for (auto& result : result_list) {
+    std::snprintf(line, sizeof(line), "%-*s %10.1f ns %12zu %13.4g",
+                  static_cast<int>(width), result.name.c_str(), result.time,
+                  result.iterations, result.items_per_second);
+    stream << line;
+    if (result.max > 0) {
+      std::snprintf(line, sizeof(line), " %8.0f ns %8.0f ns %8.0f ns %8.0f ns",
+                    result.p50, result.p90, result.p99, result.max);
+      stream << line;
+    }
+    stream << std::endl;
+  }
+}
+
+inline double Benchmarks::elapsed(Clock::time_point start, Clock::time_point end) {
+  return std::chrono::duration<double, std::nano>(end - start).count();
+}
+
+inline double Benchmarks::percentile(const std::vector<double>& sorted, double fraction) {
+  size_t index = static_cast<size_t>(fraction * (sorted.size() - 1) + 0.5);
+  return sorted[std::min(index, sorted.size() - 1)];
+}
+
+}  // namespace krpc
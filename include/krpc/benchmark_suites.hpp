@@ -0,0 +1,301 @@
+#pragma once
+
+#include <google/protobuf/stubs/port.h>
+
+#include <atomic>
+#include <chrono>  // NOLINT(build/c++11)
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <future>  // NOLINT(build/c++11)
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <tuple>
+#include <vector>
+
+#include "krpc/benchmark.hpp"
+#include "krpc/client.hpp"
+#include "krpc/decoder.hpp"
+#include "krpc/encoder.hpp"
+#include "krpc/krpc.pb.hpp"
+#include "krpc/mock_server.hpp"
+#include "krpc/services/space_center.hpp"
+#include "krpc/stream.hpp"
+
+namespace krpc {
+
+/** Benchmarks encoding and decoding values of each type. */
+void benchmark_encoding(Benchmarks& benchmarks);
+
+/**
+ * Benchmarks the latency of RPCs made to a MockServer on the loopback interface, and the
+ * rate of RPCs that are pipelined using invoke_async().
+ */
+void benchmark_rpc(Benchmarks& benchmarks, size_t iterations = 10000);
+
+/**
+ * Benchmarks the rate at which stream results are received, for each of the given numbers
+ * of streams, from a MockServer that sends updates for every stream as fast as it can.
+ * Also benchmarks reading a stream's value while it is being updated, from one thread and
+ * from the given number of threads at once, for a value held in a SeqLock (a double) and
+ * one held in a SharedValue (a string).
+ */
+void benchmark_streams(Benchmarks& benchmarks,
+                       const std::vector<size_t>& counts = {1, 10, 100, 1000},
+                       size_t readers = 4);
+
+/**
+ * Runs all of the benchmarks and writes their results to standard output. Accepts
+ * --min_time=<seconds> and --iterations=<count>, the number of RPCs timed by
+ * benchmark_rpc(). Returns the program's exit status.
+ */
+int benchmark_main(int argc, char** argv);
+
+/** Defines a main() that runs the benchmarks, for a benchmark program. */
+#define KRPC_BENCHMARK_MAIN() \
+  int main(int argc, char** argv) { return ::krpc::benchmark_main(argc, argv); }
+
+namespace benchmark {
+
+/**
+ * A MockServer that answers every request without a recorded session. AddStream returns
+ * streams with ids 1, 2, 3... and other procedures return their first argument, if any.
+ */
+class Server {
+ public:
+  explicit Server(const RecordedSession& session = RecordedSession(), bool flood = false);
+  unsigned int rpc_port() const;
+  unsigned int stream_port() const;
+
+ private:
+  static MockServerOptions options(bool flood);
+  MockServer server;
+  std::shared_ptr<std::atomic<google::protobuf::uint64>> next_id;
+};
+
+/**
+ * Calls read repeatedly from the given number of threads at once, for the minimum time,
+ * and adds the total rate of reads. The time is that of one read, on one thread.
+ */
+const BenchmarkResult& contended(Benchmarks& benchmarks, const std::string& name,
+                                 const std::function<void()>& read, size_t threads);
+
+inline Server::Server(const RecordedSession& session, bool flood) :
+  server(session, options(flood)),
+  next_id(std::make_shared<std::atomic<google::protobuf::uint64>>(1)) {
+  auto ids = next_id;
+  server.set_handler([ids] (const schema::Request& request, schema::Response& response) {
+    for (auto& call : request.calls()) {
+      schema::ProcedureResult* result = response.add_results();
+      if (call.service() == "KRPC" && call.procedure() == "AddStream") {
+        schema::Stream stream;
+        stream.set_id((*ids)++);
+        result->set_value(encoder::encode(stream));
+      } else if (call.arguments_size() > 0) {
+        result->set_value(call.arguments(0).value());
+      }
+    }
+    return true;
+  });
+}
+
+inline unsigned int Server::rpc_port() const {
+  return server.rpc_port();
+}
+
+inline unsigned int Server::stream_port() const {
+  return server.stream_port();
+}
+
+inline MockServerOptions Server::options(bool flood) {
+  MockServerOptions result;
+  if (flood) {
+    result.speed = 0;
+    result.repeat = true;
+  }
+  return result;
+}
+
+inline const BenchmarkResult& contended(Benchmarks& benchmarks, const std::string& name,
+                                        const std::function<void()>& read, size_t threads) {
+  std::atomic<bool> stop(false);
+  std::vector<size_t> reads(threads, 0);
+  std::vector<std::thread> readers;
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < threads; i++) {
+    readers.push_back(std::thread([&stop, &reads, &read, i] {
+      size_t count = 0;
+      while (!stop.load(std::memory_order_relaxed)) {
+        read();
+        count++;
+      }
+      reads[i] = count;
+    }));
+  }
+  std::this_thread::sleep_for(std::chrono::duration<double>(benchmarks.min_time()));
+  stop = true;
+  for (auto& reader : readers)
+    reader.join();
+  double seconds = std::chrono::duration<double>(
+    std::chrono::steady_clock::now() - start).count();
+  size_t total = 0;
+  for (auto count : reads)
+    total += count;
+  BenchmarkResult result;
+  result.name = name;
+  result.iterations = total;
+  result.time = total > 0 ? threads * seconds * 1e9 / total : 0;
+  result.items_per_second = total / seconds;
+  return benchmarks.add(result);
+}
+
+}  // namespace benchmark
+
+inline void benchmark_encoding(Benchmarks& benchmarks) {
+  typedef std::tuple<double, double, double> Vector3;
+  typedef std::map<std::string, services::SpaceCenter::CelestialBody> Bodies;
+  double number = 1234.5678;
+  google::protobuf::int32 integer = 123456;
+  std::string text(64, 'x');
+  Vector3 vector(1.5, -2.25, 3.125);
+  std::vector<double> list(100, 1.5);
+  Bodies bodies;
+  for (google::protobuf::uint64 i = 1; i <= 20; i++)
+    bodies["Body" + std::to_string(i)] = services::SpaceCenter::CelestialBody(nullptr, i);
+
+  // Encoding each value leaves it in data, for the decoding benchmark that follows
+  std::string data;
+  benchmarks.run("encode/double", [&] { do_not_optimize(data = encoder::encode(number)); });
+  benchmarks.run("decode/double", [&] { decoder::decode(number, data); do_not_optimize(number); });
+  benchmarks.run("encode/int32", [&] { do_not_optimize(data = encoder::encode(integer)); });
+  benchmarks.run("decode/int32", [&] { decoder::decode(integer, data); do_not_optimize(integer); });
+  benchmarks.run("encode/string", [&] { do_not_optimize(data = encoder::encode(text)); });
+  benchmarks.run("decode/string", [&] { decoder::decode(text, data); do_not_optimize(text); });
+  benchmarks.run("encode/tuple", [&] { do_not_optimize(data = encoder::encode(vector)); });
+  benchmarks.run("decode/tuple", [&] { decoder::decode(vector, data); do_not_optimize(vector); });
+  benchmarks.run("encode/list", [&] { do_not_optimize(data = encoder::encode(list)); },
+                 list.size());
+  benchmarks.run("decode/list", [&] { decoder::decode(list, data); do_not_optimize(list); },
+                 list.size());
+  benchmarks.run("encode/dictionary", [&] { do_not_optimize(data = encoder::encode(bodies)); },
+                 bodies.size());
+  benchmarks.run("decode/dictionary", [&] {
+    decoder::decode(bodies, data);
+    do_not_optimize(bodies);
+  }, bodies.size());
+}
+
+inline void benchmark_rpc(Benchmarks& benchmarks, size_t iterations) {
+  benchmark::Server server;
+  Client client("Benchmark", "127.0.0.1", server.rpc_port(), server.stream_port());
+  schema::ProcedureCall call = client.build_call("Benchmark", "Echo", {encoder::encode(1.0)});
+  schema::ProcedureCall large = client.build_call(
+    "Benchmark", "Echo", {encoder::encode(std::string(1024, 'x'))});
+
+  benchmarks.latency("rpc/invoke", [&] { do_not_optimize(client.invoke(call)); }, iterations);
+  benchmarks.latency("rpc/invoke/1KiB", [&] { do_not_optimize(client.invoke(large)); },
+                     iterations);
+  const size_t depth = 64;
+  std::vector<std::future<std::string>> results(depth);
+  benchmarks.run("rpc/invoke_async/64", [&] {
+    for (auto& result : results)
+      result = client.invoke_async(call);
+    for (auto& result : results)
+      do_not_optimize(result.get());
+  }, depth);
+}
+
+inline void benchmark_streams(Benchmarks& benchmarks, const std::vector<size_t>& counts,
+                              size_t readers) {
+  for (auto count : counts) {
+    // One update carrying a result for every stream, and for a string stream that is
+    // added last, replayed continuously
+    schema::StreamUpdate update;
+    for (size_t i = 1; i <= count; i++) {
+      schema::StreamResult* result = update.add_results();
+      result->set_id(i);
+      result->mutable_result()->set_value(encoder::encode(static_cast<double>(i)));
+    }
+    schema::StreamResult* text = update.add_results();
+    text->set_id(count + 1);
+    text->mutable_result()->set_value(encoder::encode(std::string(64, 'x')));
+    RecordedSession session;
+    session.add_update(0, update);
+    benchmark::Server server(session, true);
+    Client client("Benchmark", "127.0.0.1", server.rpc_port(), server.stream_port());
+    schema::ProcedureCall call = client.build_call("Benchmark", "Value");
+    std::vector<Stream<double>> streams;
+    for (size_t i = 0; i < count; i++)
+      streams.push_back(Stream<double>(&client, call));
+    Stream<std::string> text_stream(&client, call);
+
+    std::atomic<size_t> updates(0);
+    int tag = client.add_stream_update_callback([&updates] { updates++; });
+    auto start = std::chrono::steady_clock::now();
+    size_t first = updates.load();
+    std::this_thread::sleep_for(std::chrono::duration<double>(benchmarks.min_time()));
+    size_t received = updates.load() - first;
+    double seconds = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+    client.remove_stream_update_callback(tag);
+
+    BenchmarkResult result;
+    result.name = "stream/updates/" + std::to_string(count);
+    result.iterations = received;
+    result.time = received > 0 ? seconds * 1e9 / received : 0;
+    result.items_per_second = received * count / seconds;
+    benchmarks.add(result);
+
+    Stream<double>& stream = streams.front();
+    std::string suffix = "/" + std::to_string(count);
+    benchmarks.run("stream/read" + suffix, [&stream] { do_not_optimize(stream()); });
+    benchmarks.run("stream/read/string" + suffix,
+                   [&text_stream] { do_not_optimize(text_stream()); });
+    if (readers > 1) {
+      suffix += "/threads:" + std::to_string(readers);
+      benchmark::contended(benchmarks, "stream/read" + suffix,
+                           [&stream] { do_not_optimize(stream()); }, readers);
+      benchmark::contended(benchmarks, "stream/read/string" + suffix,
+                           [&text_stream] { do_not_optimize(text_stream()); }, readers);
+    }
+  }
+}
+
+inline int benchmark_main(int argc, char** argv) {
+  double min_time = 0.5;
+  size_t iterations = 10000;
+  for (int i = 1; i < argc; i++) {
+    std::string argument = argv[i];
+    try {
+      if (argument.compare(0, 11, "--min_time=") == 0) {
+        min_time = std::stod(argument.substr(11));
+        continue;
+      }
+      if (argument.compare(0, 13, "--iterations=") == 0) {
+        iterations = std::stoul(argument.substr(13));
+        continue;
+      }
+    } catch (const std::exception&) {
+      // The value is invalid, which is reported below
+    }
+    std::cerr << "Usage: " << argv[0] << " [--min_time=<seconds>] [--iterations=<count>]"
+              << std::endl;
+    return 1;
+  }
+  try {
+    Benchmarks benchmarks(min_time);
+    benchmark_encoding(benchmarks);
+    benchmark_rpc(benchmarks, iterations);
+    benchmark_streams(benchmarks);
+    benchmarks.report(std::cout);
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
+
+}  // namespace krpc
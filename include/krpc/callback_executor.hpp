@@ -0,0 +1,296 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>  // NOLINT(build/c++11)
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>  // NOLINT(build/c++11)
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include "krpc/client.hpp"
+#include "krpc/connection_registry.hpp"
+
+namespace krpc {
+
+class Connection;
+
+/**
+ * Runs stream callbacks away from the stream update thread, so that a slow callback
+ * does not delay updates to other streams. Tasks may be run concurrently and in any
+ * order; callbacks are ordered by posting them through a Strand. Implement this
+ * interface to run callbacks on an executor of your own.
+ */
+class CallbackExecutor {
+ public:
+  typedef std::function<void()> Task;
+  virtual ~CallbackExecutor() {}
+  /** Run a task. Must not block. */
+  virtual void post(const Task& task) = 0;
+  /** Returns the executor used for stream callbacks of a client, or nullptr. */
+  static std::shared_ptr<CallbackExecutor> get(Client * client);
+  /** Set the executor used for stream callbacks of a client. */
+  static void set(Client * client, const std::shared_ptr<CallbackExecutor>& executor);
+
+ private:
+  static ConnectionRegistry<CallbackExecutor>& registry();
+};
+
+/**
+ * Runs tasks on an executor one at a time, in the order they were posted. Each
+ * callback has its own strand, so callbacks run in parallel with each other but
+ * each one sees its updates in order. The strand only holds a weak reference to
+ * the executor; tasks posted after the executor is destroyed are discarded.
+ */
+class Strand : public std::enable_shared_from_this<Strand> {
+ public:
+  explicit Strand(const std::shared_ptr<CallbackExecutor>& executor);
+  void post(const CallbackExecutor::Task& task);
+  /** Discard queued tasks, and any tasks posted later. */
+  void close();
+
+ private:
+  void run();
+  std::weak_ptr<CallbackExecutor> executor;
+  std::mutex lock;
+  std::deque<CallbackExecutor::Task> tasks;
+  /** Whether a call to run() has been posted to the executor */
+  bool running;
+  bool closed;
+};
+
+/**
+ * A work stealing thread pool. Each worker has its own queue of tasks. Tasks posted by
+ * a worker go to its own queue, and other tasks are spread across the queues. A worker
+ * with an empty queue takes tasks from the others.
+ */
+class ThreadPool : public CallbackExecutor {
+ public:
+  /** Create a pool. If threads is zero, uses one thread per hardware thread. */
+  explicit ThreadPool(size_t threads = 0);
+  ~ThreadPool();
+  void post(const Task& task) override;
+  size_t size() const;
+
+ private:
+  struct Worker {
+    std::mutex lock;
+    std::deque<Task> tasks;
+    std::thread thread;
+  };
+  /** Shared with the workers, so that a task can release the last reference to the pool */
+  struct State {
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic<size_t> next;
+    /** Number of tasks in the queues */
+    std::atomic<size_t> pending;
+    std::mutex sleep_lock;
+    std::condition_variable wake;
+    bool stop;
+  };
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+  static void main(const std::shared_ptr<State>& state, size_t index);
+  static bool take(State& state, size_t index, Task& task);
+  static State *& current_state();
+  static size_t& current_worker();
+  std::shared_ptr<State> state;
+};
+
+inline void Client::set_callback_executor(const std::shared_ptr<CallbackExecutor>& executor) {
+  CallbackExecutor::set(this, executor);
+}
+
+inline int Client::add_stream_update_callback(
+  const Callback& callback, const std::shared_ptr<CallbackExecutor>& executor) {
+  std::shared_ptr<Strand> strand = std::make_shared<Strand>(executor);
+  // The strand only holds a weak reference, so keep the executor alive while the callback is
+  std::shared_ptr<CallbackExecutor> owner = executor;
+  return add_stream_update_callback([strand, owner, callback] { strand->post(callback); });
+}
+
+inline std::shared_ptr<CallbackExecutor> CallbackExecutor::get(Client * client) {
+  return registry().get(client->rpc_connection);
+}
+
+inline void CallbackExecutor::set(Client * client,
+                                  const std::shared_ptr<CallbackExecutor>& executor) {
+  registry().set(client->rpc_connection, executor);
+}
+
+inline ConnectionRegistry<CallbackExecutor>& CallbackExecutor::registry() {
+  static ConnectionRegistry<CallbackExecutor> executors;
+  return executors;
+}
+
+inline Strand::Strand(const std::shared_ptr<CallbackExecutor>& executor) :
+  executor(executor), running(false), closed(false) {
+}
+
+inline void Strand::post(const CallbackExecutor::Task& task) {
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    if (closed)
+      return;
+    tasks.push_back(task);
+    if (running)
+      return;
+    running = true;
+  }
+  std::shared_ptr<CallbackExecutor> executor = this->executor.lock();
+  if (!executor) {
+    close();
+    return;
+  }
+  std::shared_ptr<Strand> self = shared_from_this();
+  executor->post([self] { self->run(); });
+}
+
+inline void Strand::close() {
+  std::lock_guard<std::mutex> guard(lock);
+  closed = true;
+  tasks.clear();
+}
+
+inline void Strand::run() {
+  // Run the tasks that are queued now, then yield the executor to other strands
+  std::deque<CallbackExecutor::Task> batch;
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    batch.swap(tasks);
+  }
+  for (auto& task : batch) {
+    {
+      std::lock_guard<std::mutex> guard(lock);
+      if (closed)
+        break;
+    }
+    try {
+      task();
+    } catch (...) {
+      // Exceptions thrown by callbacks are discarded, as there is no caller to raise them in
+    }
+  }
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    if (tasks.empty() || closed) {
+      running = false;
+      return;
+    }
+  }
+  std::shared_ptr<CallbackExecutor> executor = this->executor.lock();
+  if (!executor) {
+    std::lock_guard<std::mutex> guard(lock);
+    tasks.clear();
+    closed = true;
+    running = false;
+    return;
+  }
+  std::shared_ptr<Strand> self = shared_from_this();
+  executor->post([self] { self->run(); });
+}
+
+inline ThreadPool::ThreadPool(size_t threads) : state(std::make_shared<State>()) {
+  if (threads == 0)
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  state->next = 0;
+  state->pending = 0;
+  state->stop = false;
+  for (size_t i = 0; i < threads; i++)
+    state->workers.emplace_back(new Worker);
+  for (size_t i = 0; i < threads; i++)
+    state->workers[i]->thread = std::thread(&ThreadPool::main, state, i);
+}
+
+inline ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> guard(state->sleep_lock);
+    state->stop = true;
+  }
+  state->wake.notify_all();
+  for (auto& worker : state->workers) {
+    // A worker can't join itself, if one of its tasks released the last reference
+    if (worker->thread.get_id() == std::this_thread::get_id())
+      worker->thread.detach();
+    else
+      worker->thread.join();
+  }
+}
+
+inline void ThreadPool::post(const Task& task) {
+  size_t index;
+  if (current_state() == state.get())
+    index = current_worker();
+  else
+    index = state->next++ % state->workers.size();
+  Worker& worker = *state->workers[index];
+  {
+    std::lock_guard<std::mutex> guard(worker.lock);
+    worker.tasks.push_back(task);
+  }
+  state->pending++;
+  {
+    std::lock_guard<std::mutex> guard(state->sleep_lock);
+  }
+  state->wake.notify_one();
+}
+
+inline size_t ThreadPool::size() const {
+  return state->workers.size();
+}
+
+inline void ThreadPool::main(const std::shared_ptr<State>& state, size_t index) {
+  current_state() = state.get();
+  current_worker() = index;
+  while (true) {
+    Task task;
+    if (take(*state, index, task)) {
+      try {
+        task();
+      } catch (...) {
+        // Exceptions thrown by tasks are discarded, as there is no caller to raise them in
+      }
+      continue;
+    }
+    std::unique_lock<std::mutex> guard(state->sleep_lock);
+    state->wake.wait(guard, [&state] { return state->stop || state->pending > 0; });
+    if (state->stop)
+      return;
+  }
+}
+
+inline bool ThreadPool::take(State& state, size_t index, Task& task) {
+  size_t size = state.workers.size();
+  for (size_t i = 0; i < size; i++) {
+    // Take from the front of our own queue, or steal from the back of another
+    Worker& worker = *state.workers[(index + i) % size];
+    std::lock_guard<std::mutex> guard(worker.lock);
+    if (worker.tasks.empty())
+      continue;
+    if (i == 0) {
+      task.swap(worker.tasks.front());
+      worker.tasks.pop_front();
+    } else {
+      task.swap(worker.tasks.back());
+      worker.tasks.pop_back();
+    }
+    state.pending--;
+    return true;
+  }
+  return false;
+}
+
+inline ThreadPool::State *& ThreadPool::current_state() {
+  static thread_local State * state = nullptr;
+  return state;
+}
+
+inline size_t& ThreadPool::current_worker() {
+  static thread_local size_t worker = 0;
+  return worker;
+}
+
+}  // namespace krpc
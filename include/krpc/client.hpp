@@ -2,8 +2,12 @@
 
 #include <google/protobuf/stubs/port.h>
 
+#include <chrono>  // NOLINT(build/c++11)
 #include <condition_variable>  // NOLINT(build/c++11)
+#include <cstddef>
+#include <exception>
 #include <functional>
+#include <future>  // NOLINT(build/c++11)
 #include <map>
 #include <memory>
 #include <mutex>  // NOLINT(build/c++11)
@@ -11,13 +15,25 @@
 #include <utility>
 #include <vector>
 
+#include "krpc/client_stats.hpp"
+#include "krpc/connection.hpp"
+#include "krpc/connection_registry.hpp"
+#include "krpc/error.hpp"
 #include "krpc/krpc.pb.hpp"
+#include "krpc/procedure_table.hpp"
 
 namespace krpc {
 
+class Batch;
+class CallbackExecutor;
 class Connection;
+struct ConnectionOptions;
+class CoroutineExecutor;
+class InvokeBuffers;
+class Pipeline;
 class StreamManager;
 class StreamImpl;
+class VesselSnapshot;
 
 class Client {
  public:
@@ -31,6 +47,27 @@ class Client {
     const std::string& service, const std::string& procedure,
     const std::vector<std::string>& args = std::vector<std::string>());
 
+  /**
+   * Invoke a procedure using buffers that are reused from one call to the next, so that
+   * calling procedures repeatedly does not allocate memory. Returns the encoded return
+   * value, which is valid until the buffers are next used. Requires krpc/invoke_buffers.hpp.
+   */
+  const std::string& invoke(const schema::ProcedureCall& call, InvokeBuffers& buffers);
+
+  /**
+   * Invoke a remote procedure without waiting for the result. Calls made from any
+   * number of threads are pipelined on the RPC connection, and responses are matched
+   * to calls in the order they were sent. Requires krpc/pipeline.hpp.
+   */
+  std::future<std::string> invoke_async(const schema::ProcedureCall& call);
+  typedef std::function<void(const std::string&, const std::exception_ptr&)> ResultHandler;
+  /**
+   * Invoke a remote procedure without waiting for the result. The handler is passed
+   * the encoded return value, or the exception raised by the call. It is invoked on
+   * the thread that receives responses, so must not block.
+   */
+  void invoke_async(const schema::ProcedureCall& call, const ResultHandler& handler);
+
   schema::Request build_request(
     const std::string& service, const std::string& procedure,
     const std::vector<std::string>& args = std::vector<std::string>());
@@ -40,9 +77,74 @@ class Client {
   void add_exception_thrower(const std::string& service, const std::string& name,
                              const std::function<void(std::string)>& thrower);
 
+  /**
+   * Overloads of invoke and build_call for procedure names given as string literals,
+   * as used by the generated services. Once use_procedure_ids() has been called, these
+   * identify the procedure using its numeric service and procedure IDs instead of names.
+   */
+  template <size_t N, size_t M> std::string invoke(
+    const char (&service)[N], const char (&procedure)[M],
+    const std::vector<std::string>& args = std::vector<std::string>());
+  template <size_t N, size_t M> schema::ProcedureCall build_call(
+    const char (&service)[N], const char (&procedure)[M],
+    const std::vector<std::string>& args = std::vector<std::string>());
+  /**
+   * Fetch the services from the server, and from then on call procedures using numeric
+   * IDs instead of service and procedure names. This reduces the size of each request,
+   * and avoids a name lookup on the server. Applies to all clients sharing this
+   * client's RPC connection.
+   */
+  void use_procedure_ids();
+
+  /**
+   * Create a batch of procedure calls that are sent to the server in a single
+   * request. Requires krpc/batch.hpp.
+   */
+  Batch batch();
+
+  /**
+   * Collect statistics of the procedures called by the generated services, for all
+   * clients sharing this client's RPC connection. Pass false to stop collecting them,
+   * and discard those collected so far.
+   */
+  void enable_stats(bool enabled = true);
+  /** The statistics collected since enable_stats() was called. */
+  ClientStatsSnapshot stats() const;
+
+  /**
+   * Set options on the sockets of this client's RPC and stream connections, which are
+   * shared with copies of the client. Requires krpc.hpp.
+   */
+  void set_connection_options(const ConnectionOptions& options);
+
+  /**
+   * Send the calls made by the generated services, and by use_procedure_ids(), through a
+   * transport rather than the RPC connection, for all clients sharing this client's RPC
+   * connection. The transport must have completed the connection handshake, as done by
+   * connect(transport) in krpc/transport.hpp. Calls made using the other overloads of
+   * invoke(), batches, invoke_async() and streams still use the connections to the
+   * server. Pass nullptr to stop using the transport.
+   */
+  void use_transport(const std::shared_ptr<Transport>& transport);
+
  private:
+  friend class Batch;
+  friend class CallbackExecutor;
+  friend class CoroutineExecutor;
+  friend class Pipeline;
   friend class StreamManager;
+  friend class VesselSnapshot;
   void throw_exception(const schema::Error& error) const;
+  /**
+   * Send a call through the transport, or through the RPC connection if it is null, and
+   * return its result. If counters is not null, records the time taken by each phase of
+   * the call, from start, when the call started being built.
+   */
+  std::string send_call(schema::ProcedureCall call, Transport* transport,
+                        ClientStats::Procedure* counters,
+                        std::chrono::steady_clock::time_point start);
+  /** The transports used by RPC connections, set by use_transport() */
+  static ConnectionRegistry<Transport>& transports();
 
  public:
   std::shared_ptr<StreamImpl> add_stream(const schema::ProcedureCall& call);
@@ -73,8 +175,22 @@ class Client {
    * and allows it to be removed using remove_stream_update_callback()
    */
   int add_stream_update_callback(const Callback& callback);
+  /**
+   * Add a callback that is run on an executor, rather than on the stream update thread.
+   * Invocations of the callback are run one at a time, in order. The executor is kept
+   * alive until the callback is removed. Requires krpc/callback_executor.hpp.
+   */
+  int add_stream_update_callback(const Callback& callback,
+                                 const std::shared_ptr<CallbackExecutor>& executor);
   /** Remove a callback, based on its tag */
   void remove_stream_update_callback(int tag);
+  /**
+   * Run the callbacks added by Stream<T>::add_callback on an executor, rather than on
+   * the stream update thread. Applies to callbacks added afterwards, by all clients
+   * sharing this client's RPC connection. Pass nullptr to run them on the stream update
+   * thread again. Requires krpc/callback_executor.hpp.
+   */
+  void set_callback_executor(const std::shared_ptr<CallbackExecutor>& executor);
 
  private:
   std::shared_ptr<Connection> rpc_connection;
@@ -84,4 +200,130 @@ class Client {
            std::function<void(std::string)>> exception_throwers;
 };
 
+template <size_t N, size_t M> inline std::string Client::invoke(
+  const char (&service)[N], const char (&procedure)[M], const std::vector<std::string>& args) {
+  std::shared_ptr<Transport> transport = transports().get(rpc_connection);
+  std::shared_ptr<ClientStats> stats = ClientStats::get(rpc_connection);
+  if (!transport && !stats)
+    return invoke(build_call(service, procedure, args));
+  ClientStats::Procedure* counters = stats ? &stats->procedure(service, procedure) : nullptr;
+  auto start = std::chrono::steady_clock::now();
+  return send_call(build_call(service, procedure, args), transport.get(), counters, start);
+}
+
+template <size_t N, size_t M> inline schema::ProcedureCall Client::build_call(
+  const char (&service)[N], const char (&procedure)[M], const std::vector<std::string>& args) {
+  schema::ProcedureCall call;
+  std::shared_ptr<const ProcedureTable> table = ProcedureTable::get(rpc_connection);
+  if (!table || !table->find(service, procedure, call)) {
+    call.set_service(service);
+    call.set_procedure(procedure);
+  }
+  for (size_t i = 0; i < args.size(); i++) {
+    schema::Argument* argument = call.add_arguments();
+    argument->set_position(static_cast<google::protobuf::uint32>(i));
+    argument->set_value(args[i]);
+  }
+  return call;
+}
+
+inline void Client::use_transport(const std::shared_ptr<Transport>& transport) {
+  if (!rpc_connection) {
+    // A client that is not connected to a server, such as one created by connect(transport),
+    // needs a connection to identify it, which is never connected
+    rpc_connection = std::make_shared<Connection>("", 0);
+    lock = std::make_shared<std::mutex>();
+  }
+  transports().set(rpc_connection, transport);
+}
+
+inline std::string Client::send_call(schema::ProcedureCall call, Transport* transport,
+                                     ClientStats::Procedure* counters,
+                                     std::chrono::steady_clock::time_point start) {
+  // Sends the request inline, as InvokeBuffers does, so that each phase can be timed
+  typedef std::chrono::steady_clock Clock;
+  if (counters)
+    counters->calls++;
+  try {
+    schema::Request request;
+    request.add_calls()->Swap(&call);
+    std::string data;
+    request.SerializeToString(&data);
+    size_t request_bytes = data.size();
+    Clock::time_point encoded = Clock::now();
+    Clock::time_point sending, sent, received;
+    {
+      std::lock_guard<std::mutex> guard(*lock);
+      sending = Clock::now();
+      if (transport)
+        transport->send_message(data.data(), data.size());
+      else
+        rpc_connection->send_message(data.data(), data.size());
+      sent = Clock::now();
+      if (transport)
+        transport->receive_message(data);
+      else
+        rpc_connection->receive_message(data);
+      received = Clock::now();
+    }
+    schema::Response response;
+    if (!response.ParseFromString(data))
+      throw EncodingError("Failed to decode response");
+    if (counters) {
+      Clock::time_point decoded = Clock::now();
+      typedef LatencyHistogram ClientStats::Procedure::* Phase;
+      const Phase phases[] = {&ClientStats::Procedure::encode, &ClientStats::Procedure::send,
+                              &ClientStats::Procedure::wait, &ClientStats::Procedure::decode,
+                              &ClientStats::Procedure::round_trip};
+      const Clock::duration durations[] = {
+        encoded - start, sent - sending, received - sent, decoded - received, decoded - sending};
+      for (size_t i = 0; i < 5; i++)
+        (counters->*phases[i]).record(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(durations[i]).count());
+      counters->request_bytes += request_bytes;
+    }
+    if (response.has_error())
+      throw_exception(response.error());
+    if (response.results_size() != 1)
+      throw RPCError("Request returned an unexpected number of results");
+    schema::ProcedureResult* result = response.mutable_results(0);
+    if (result->has_error())
+      throw_exception(result->error());
+    if (counters)
+      counters->response_bytes += result->value().size();
+    std::string value;
+    value.swap(*result->mutable_value());
+    return value;
+  } catch (...) {
+    if (counters)
+      counters->errors++;
+    throw;
+  }
+}
+
+inline ConnectionRegistry<Transport>& Client::transports() {
+  static ConnectionRegistry<Transport> transports;
+  return transports;
+}
+
+inline void Client::use_procedure_ids() {
+  ProcedureTable::set(rpc_connection, nullptr);
+  schema::Services services;
+  if (!services.ParseFromString(invoke("KRPC", "GetServices")))
+    throw RPCError("Failed to decode services");
+  ProcedureTable::set(rpc_connection, std::make_shared<ProcedureTable>(services));
+}
+
+inline void Client::enable_stats(bool enabled) {
+  if (!enabled)
+    ClientStats::set(rpc_connection, nullptr);
+  else if (!ClientStats::get(rpc_connection))
+    ClientStats::set(rpc_connection, std::make_shared<ClientStats>());
+}
+
+inline ClientStatsSnapshot Client::stats() const {
+  std::shared_ptr<ClientStats> stats = ClientStats::get(rpc_connection);
+  return stats ? stats->snapshot() : ClientStatsSnapshot();
+}
+
 }  // namespace krpc
@@ -0,0 +1,401 @@
+#pragma once
+
+#include <google/protobuf/stubs/port.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>  // NOLINT(build/c++11)
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "krpc/connection_registry.hpp"
+
+namespace krpc {
+
+class Connection;
+
+/** A summary of the durations recorded by a LatencyHistogram, in nanoseconds. */
+struct LatencySummary {
+  google::protobuf::uint64 count;
+  double mean;
+  google::protobuf::uint64 p50;
+  google::protobuf::uint64 p90;
+  google::protobuf::uint64 p99;
+  google::protobuf::uint64 max;
+};
+
+/**
+ * A histogram of durations in nanoseconds, in the style of HdrHistogram. Each power of two
+ * is split into 16 linear buckets, so percentiles are accurate to within about 3%, using
+ * a fixed 5KB of counters. Durations longer than about 18 minutes are counted as 18 minutes.
+ * Recording is lock free and can be done from any thread.
+ */
+class LatencyHistogram {
+ public:
+  LatencyHistogram();
+  void record(google::protobuf::uint64 nanoseconds);
+  LatencySummary summary() const;
+  void reset();
+
+ private:
+  LatencyHistogram(const LatencyHistogram&) = delete;
+  LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+  static const unsigned int sub_bucket_bits = 4;
+  static const unsigned int max_bits = 40;
+  static const size_t bucket_count = (max_bits - sub_bucket_bits + 1) << sub_bucket_bits;
+  static size_t index(google::protobuf::uint64 value);
+  /** The value in the middle of a bucket */
+  static google::protobuf::uint64 value(size_t index);
+  std::vector<std::atomic<google::protobuf::uint64>> counts;
+  std::atomic<google::protobuf::uint64> total;
+  std::atomic<google::protobuf::uint64> largest;
+};
+
+/** Statistics of the calls made to a procedure. Durations are in nanoseconds. */
+struct ProcedureStats {
+  std::string service;
+  std::string procedure;
+  google::protobuf::uint64 calls;
+  /** Number of calls that threw an exception */
+  google::protobuf::uint64 errors;
+  /** Total size of the encoded requests */
+  google::protobuf::uint64 request_bytes;
+  /** Total size of the encoded return values */
+  google::protobuf::uint64 response_bytes;
+  /** Time taken to build the procedure call from the encoded arguments, and encode the request */
+  LatencySummary encode;
+  /** Time taken to write the request to the connection, once the client's lock is held */
+  LatencySummary send;
+  /**
+   * Time from sending the request to having received the response, which includes the
+   * time the request waited on the server for its next update.
+   */
+  LatencySummary wait;
+  /** Time taken to parse the response */
+  LatencySummary decode;
+  /** Time from sending the request to having parsed the response */
+  LatencySummary round_trip;
+};
+
+/** A snapshot of the statistics collected by ClientStats. */
+struct ClientStatsSnapshot {
+  std::vector<ProcedureStats> procedures;
+  /** The statistics as a JSON object, with durations in nanoseconds. */
+  std::string json() const;
+  /**
+   * The statistics in the Prometheus text exposition format, with durations in seconds.
+   * The names of the metrics start with the given prefix.
+   */
+  std::string prometheus(const std::string& prefix = "krpc") const;
+};
+
+/**
+ * Statistics of the procedures called by the generated services on an RPC connection.
+ * Enabled using Client::enable_stats(). When no connection has statistics enabled, each
+ * call checks a single atomic counter, and otherwise finds the counters for a procedure
+ * without taking a lock.
+ */
+class ClientStats {
+ public:
+  struct Procedure {
+    Procedure();
+    std::atomic<google::protobuf::uint64> calls;
+    std::atomic<google::protobuf::uint64> errors;
+    std::atomic<google::protobuf::uint64> request_bytes;
+    std::atomic<google::protobuf::uint64> response_bytes;
+    LatencyHistogram encode;
+    LatencyHistogram send;
+    LatencyHistogram wait;
+    LatencyHistogram decode;
+    LatencyHistogram round_trip;
+  };
+  ClientStats();
+  /**
+   * Returns the counters for a procedure. The names are usually string literals, whose
+   * addresses are used to find the counters without comparing the strings, or taking a
+   * lock once the procedure has been called before.
+   */
+  Procedure& procedure(const char* service, const char* procedure);
+  ClientStatsSnapshot snapshot() const;
+  /** Whether any connection that is still open has statistics enabled. */
+  static bool enabled();
+  /** Returns the statistics of an RPC connection, or nullptr if they are not enabled. */
+  static std::shared_ptr<ClientStats> get(const std::shared_ptr<Connection>& connection);
+  /** Set the statistics of an RPC connection. Pass nullptr to disable them. */
+  static void set(const std::shared_ptr<Connection>& connection,
+                  const std::shared_ptr<ClientStats>& stats);
+
+ private:
+  ClientStats(const ClientStats&) = delete;
+  ClientStats& operator=(const ClientStats&) = delete;
+  typedef std::pair<std::string, std::string> Name;
+  /** The counters for a pair of names, found by their addresses */
+  struct Literal {
+    const char* service;
+    const char* procedure;
+    Procedure* counters;
+  };
+  /**
+   * Number of slots in the table of literals. It is at most half full, so lookups stop at
+   * an empty slot; procedures called once it is full are found in procedures instead.
+   */
+  static const size_t literal_slots = 4096;
+  static size_t hash(const char* service, const char* procedure);
+  static ConnectionRegistry<ClientStats>& registry();
+  mutable std::mutex lock;
+  std::map<Name, std::unique_ptr<Procedure>> procedures;
+  /**
+   * An open addressing hash table of the literals, read without the lock. Slots are only
+   * filled, while holding the lock, and never cleared.
+   */
+  std::vector<std::atomic<const Literal*>> literals;
+  std::vector<std::unique_ptr<Literal>> literal_list;
+};
+
+inline LatencyHistogram::LatencyHistogram() : counts(bucket_count), total(0), largest(0) {
+}
+
+inline void LatencyHistogram::record(google::protobuf::uint64 nanoseconds) {
+  counts[index(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+  total.fetch_add(nanoseconds, std::memory_order_relaxed);
+  google::protobuf::uint64 current = largest.load(std::memory_order_relaxed);
+  while (nanoseconds > current &&
+         !largest.compare_exchange_weak(current, nanoseconds, std::memory_order_relaxed)) {}
+}
+
+inline LatencySummary LatencyHistogram::summary() const {
+  std::vector<google::protobuf::uint64> snapshot(bucket_count);
+  google::protobuf::uint64 count = 0;
+  for (size_t i = 0; i < bucket_count; i++) {
+    snapshot[i] = counts[i].load(std::memory_order_relaxed);
+    count += snapshot[i];
+  }
+  LatencySummary result;
+  result.count = count;
+  result.mean = count > 0 ? static_cast<double>(total.load(std::memory_order_relaxed)) / count : 0;
+  result.max = largest.load(std::memory_order_relaxed);
+  const double fractions[] = {0.5, 0.9, 0.99};
+  google::protobuf::uint64* percentiles[] = {&result.p50, &result.p90, &result.p99};
+  for (size_t i = 0; i < 3; i++) {
+    // The smallest value with at least the given fraction of the values at or below it
+    google::protobuf::uint64 rank = static_cast<google::protobuf::uint64>(
+      fractions[i] * count + 0.999999);
+    google::protobuf::uint64 seen = 0;
+    *percentiles[i] = 0;
+    for (size_t j = 0; j < bucket_count && count > 0; j++) {
+      seen += snapshot[j];
+      if (seen >= rank) {
+        *percentiles[i] = std::min(value(j), result.max);
+        break;
+      }
+    }
+  }
+  return result;
+}
+
+inline void LatencyHistogram::reset() {
+  for (auto& count : counts)
+    count.store(0, std::memory_order_relaxed);
+  total.store(0, std::memory_order_relaxed);
+  largest.store(0, std::memory_order_relaxed);
+}
+
+inline size_t LatencyHistogram::index(google::protobuf::uint64 value) {
+  const google::protobuf::uint64 linear = 1 << sub_bucket_bits;
+  value = std::min(value, (google::protobuf::uint64(1) << max_bits) - 1);
+  if (value < linear)
+    return static_cast<size_t>(value);
+  unsigned int bits = 0;
+  while ((value >> bits) >= 2 * linear)
+    bits++;
+  return static_cast<size_t>(((bits + 1) << sub_bucket_bits) + (value >> bits) - linear);
+}
+
+inline google::protobuf::uint64 LatencyHistogram::value(size_t index) {
+  const google::protobuf::uint64 linear = 1 << sub_bucket_bits;
+  if (index < linear)
+    return index;
+  unsigned int bits = static_cast<unsigned int>(index >> sub_bucket_bits) - 1;
+  google::protobuf::uint64 lower = (linear + (index & (linear - 1))) << bits;
+  return lower + ((google::protobuf::uint64(1) << bits) >> 1);
+}
+
+inline ClientStats::Procedure::Procedure() :
+  calls(0), errors(0), request_bytes(0), response_bytes(0) {
+}
+
+inline ClientStats::ClientStats() : literals(literal_slots) {
+}
+
+inline ClientStats::Procedure& ClientStats::procedure(const char* service, const char* procedure) {
+  const size_t mask = literal_slots - 1;
+  size_t slot = hash(service, procedure) & mask;
+  for (;; slot = (slot + 1) & mask) {
+    const Literal* literal = literals[slot].load(std::memory_order_acquire);
+    if (!literal)
+      break;
+    if (literal->service == service && literal->procedure == procedure)
+      return *literal->counters;
+  }
+  std::lock_guard<std::mutex> guard(lock);
+  std::unique_ptr<Procedure>& entry = procedures[Name(service, procedure)];
+  if (!entry)
+    entry.reset(new Procedure);
+  if (literal_list.size() < literal_slots / 2) {
+    // Another thread may have added the literal since the lookup, in a later slot
+    for (;; slot = (slot + 1) & mask) {
+      const Literal* literal = literals[slot].load(std::memory_order_relaxed);
+      if (!literal) {
+        literal_list.push_back(std::unique_ptr<Literal>(
+          new Literal{service, procedure, entry.get()}));
+        literals[slot].store(literal_list.back().get(), std::memory_order_release);
+        break;
+      }
+      if (literal->service == service && literal->procedure == procedure)
+        break;
+    }
+  }
+  return *entry;
+}
+
+inline ClientStatsSnapshot ClientStats::snapshot() const {
+  ClientStatsSnapshot result;
+  std::lock_guard<std::mutex> guard(lock);
+  for (auto& entry : procedures) {
+    ProcedureStats stats;
+    stats.service = entry.first.first;
+    stats.procedure = entry.first.second;
+    stats.calls = entry.second->calls;
+    stats.errors = entry.second->errors;
+    stats.request_bytes = entry.second->request_bytes;
+    stats.response_bytes = entry.second->response_bytes;
+    stats.encode = entry.second->encode.summary();
+    stats.send = entry.second->send.summary();
+    stats.wait = entry.second->wait.summary();
+    stats.decode = entry.second->decode.summary();
+    stats.round_trip = entry.second->round_trip.summary();
+    result.procedures.push_back(stats);
+  }
+  return result;
+}
+
+inline bool ClientStats::enabled() {
+  return !registry().empty();
+}
+
+inline std::shared_ptr<ClientStats> ClientStats::get(
+  const std::shared_ptr<Connection>& connection) {
+  return registry().get(connection);
+}
+
+inline void ClientStats::set(const std::shared_ptr<Connection>& connection,
+                             const std::shared_ptr<ClientStats>& stats) {
+  registry().set(connection, stats);
+}
+
+inline size_t ClientStats::hash(const char* service, const char* procedure) {
+  size_t value = std::hash<const char*>()(service) * 31 + std::hash<const char*>()(procedure);
+  // Mix the high bits into the low bits used to pick a slot
+  return value ^ (value >> 7) ^ (value >> 17);
+}
+
+inline ConnectionRegistry<ClientStats>& ClientStats::registry() {
+  static ConnectionRegistry<ClientStats> stats;
+  return stats;
+}
+
+namespace stats {
+
+inline void write_json(std::ostream& stream, const LatencySummary& summary) {
+  stream << "{\"count\":" << summary.count << ",\"mean\":" << summary.mean
+         << ",\"p50\":" << summary.p50 << ",\"p90\":" << summary.p90
+         << ",\"p99\":" << summary.p99 << ",\"max\":" << summary.max << "}";
+}
+
+inline void write_prometheus(std::ostream& stream, const std::string& name,
+                             const std::string& labels, const LatencySummary& summary) {
+  const char* quantiles[] = {"0.5", "0.9", "0.99"};
+  const google::protobuf::uint64 values[] = {summary.p50, summary.p90, summary.p99};
+  for (size_t i = 0; i < 3; i++)
+    stream << name << "{" << labels << ",quantile=\"" << quantiles[i] << "\"} "
+           << values[i] / 1e9 << "\n";
+  stream << name << "_sum{" << labels << "} " << summary.mean * summary.count / 1e9 << "\n"
+         << name << "_count{" << labels << "} " << summary.count << "\n";
+}
+
+/** Escape a string for use in JSON, or in a Prometheus label value. */
+inline std::string escape(const std::string& value) {
+  std::string result;
+  for (auto c : value) {
+    if (c == '"' || c == '\\')
+      result += '\\';
+    result += c;
+  }
+  return result;
+}
+
+}  // namespace stats
+
+inline std::string ClientStatsSnapshot::json() const {
+  std::ostringstream stream;
+  stream.precision(12);
+  stream << "{\"procedures\":[";
+  for (size_t i = 0; i < procedures.size(); i++) {
+    const ProcedureStats& entry = procedures[i];
+    if (i > 0)
+      stream << ",";
+    stream << "{\"service\":\"" << stats::escape(entry.service)
+           << "\",\"procedure\":\"" << stats::escape(entry.procedure)
+           << "\",\"calls\":" << entry.calls << ",\"errors\":" << entry.errors
+           << ",\"request_bytes\":" << entry.request_bytes
+           << ",\"response_bytes\":" << entry.response_bytes;
+    const char* names[] = {"encode", "send", "wait", "decode", "round_trip"};
+    const LatencySummary* summaries[] = {
+      &entry.encode, &entry.send, &entry.wait, &entry.decode, &entry.round_trip};
+    for (size_t j = 0; j < 5; j++) {
+      stream << ",\"" << names[j] << "\":";
+      stats::write_json(stream, *summaries[j]);
+    }
+    stream << "}";
+  }
+  stream << "]}";
+  return stream.str();
+}
+
+inline std::string ClientStatsSnapshot::prometheus(const std::string& prefix) const {
+  std::ostringstream stream;
+  stream.precision(12);
+  const char* counters[] = {"calls", "errors", "request_bytes", "response_bytes"};
+  for (size_t i = 0; i < 4; i++) {
+    std::string name = prefix + "_procedure_" + counters[i] + "_total";
+    stream << "# TYPE " << name << " counter\n";
+    for (auto& entry : procedures) {
+      const google::protobuf::uint64 values[] = {
+        entry.calls, entry.errors, entry.request_bytes, entry.response_bytes};
+      stream << name << "{service=\"" << stats::escape(entry.service) << "\",procedure=\""
+             << stats::escape(entry.procedure) << "\"} " << values[i] << "\n";
+    }
+  }
+  const char* histograms[] = {"encode", "send", "wait", "decode", "round_trip"};
+  for (size_t i = 0; i < 5; i++) {
+    std::string name = prefix + "_procedure_" + histograms[i] + "_seconds";
+    stream << "# TYPE " << name << " summary\n";
+    for (auto& entry : procedures) {
+      const LatencySummary* summaries[] = {
+        &entry.encode, &entry.send, &entry.wait, &entry.decode, &entry.round_trip};
+      std::string labels = "service=\"" + stats::escape(entry.service) + "\",procedure=\"" +
+                           stats::escape(entry.procedure) + "\"";
+      stats::write_prometheus(stream, name, labels, *summaries[i]);
+    }
+  }
+  return stream.str();
+}
+
+}  // namespace krpc
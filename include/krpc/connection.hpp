@@ -1,18 +1,70 @@
 #pragma once
 
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/message.h>
+#include <google/protobuf/stubs/port.h>
+
+#include <array>
+#include <cerrno>
 #include <chrono>  // NOLINT(build/c++11)
 #include <cstddef>
 #include <string>
 
+#ifdef __linux__
+#include <sys/socket.h>
+#endif
+
 #ifndef ASIO_STANDALONE
 #define ASIO_STANDALONE
 #endif
 #include <asio/io_service.hpp>
 #include <asio/ip/tcp.hpp>
+#include <asio/read.hpp>
+#include <asio/write.hpp>
 // IWYU pragma: no_include <asio/impl/io_service.ipp>
 
+#include "krpc/error.hpp"
+
 namespace krpc {
 
+class CoroutineExecutor;
+
+/**
+ * The size of the largest message that is received, in bytes. A larger size is most likely
+ * corrupt, and is rejected rather than allocating a buffer for it.
+ */
+const size_t MAX_MESSAGE_SIZE = 256 << 20;
+
+/** Options for the sockets of a client's connections. */
+struct ConnectionOptions {
+  ConnectionOptions() : no_delay(true), send_buffer_size(0), receive_buffer_size(0),
+                        busy_poll(0) {}
+  /**
+   * Disable Nagle's algorithm (TCP_NODELAY), so that small requests are sent immediately
+   * rather than held back waiting for the acknowledgement of earlier data.
+   */
+  bool no_delay;
+  /**
+   * Sizes of the socket's send and receive buffers, in bytes. Zero leaves the system's
+   * default. A larger receive buffer lets a large response, such as that of
+   * KRPC::get_services(), arrive without the server waiting for it to be read.
+   */
+  int send_buffer_size;
+  int receive_buffer_size;
+  /**
+   * Busy poll for data for up to this many microseconds before a receive blocks
+   * (SO_BUSY_POLL). Linux only. Zero disables it.
+   */
+  int busy_poll;
+};
+
+/**
+ * Set options on a TCP socket, for a Connection or a TcpTransport. Throws ConnectionError
+ * if one can't be set.
+ */
+template <typename Socket>
+void set_socket_options(Socket& socket, const ConnectionOptions& options);
+
 class Connection {
  public:
   Connection(const std::string& address, unsigned int port);
@@ -28,7 +80,25 @@ class Connection {
   /** Receive up to length bytes of data from the connection. */
   std::string partial_receive(size_t length,
                               std::chrono::milliseconds timeout = std::chrono::milliseconds(10));
+  /**
+   * Send a message prefixed with its size. The message is encoded into buffer, which keeps
+   * its capacity from one call to the next, and the size and message are sent together in
+   * one vectored write. Blocks until the message has been sent.
+   */
+  void send_message(const google::protobuf::Message& message, std::string& buffer);
+  /** Send data prefixed with its size, in one vectored write. */
+  void send_message(const char* data, size_t length);
+  /**
+   * Receive a message into buffer, keeping its capacity, so that receiving a message no
+   * larger than those received before does not allocate memory. Blocks until a message has
+   * been received. Throws EncodingError if the message is larger than MAX_MESSAGE_SIZE.
+   */
+  void receive_message(std::string& buffer);
+  /** Set options on the connection's socket. Throws ConnectionError if one can't be set. */
+  void set_options(const ConnectionOptions& options);
+
  private:
+  friend class CoroutineExecutor;
   asio::io_service io_service;
   asio::ip::tcp::socket socket;
   const std::string address;
@@ -36,4 +106,137 @@ class Connection {
   asio::ip::tcp::resolver resolver;
 };
 
+/**
+ * A byte stream between a client and a server, over which kRPC messages are sent prefixed
+ * with their size. Implementations must allow close() to be called from another thread, to
+ * interrupt a blocked receive(). The kRPC server only provides TCP connections; the other
+ * transports in krpc/transport.hpp are for servers on the same host. A client's procedure
+ * calls are sent through a transport using Client::use_transport().
+ */
+class Transport {
+ public:
+  virtual ~Transport() {}
+  /** Send header followed by data. Blocks until both have been sent. */
+  virtual void send(const char* header, size_t header_length,
+                    const char* data, size_t length) = 0;
+  /** Receive exactly length bytes. Throws ConnectionError if the transport is closed. */
+  virtual void receive(char* data, size_t length) = 0;
+  virtual void close() = 0;
+  /** Send a message prefixed with its size, encoding it into buffer, which is reused. */
+  void send_message(const google::protobuf::Message& message, std::string& buffer);
+  /** Send data prefixed with its size. */
+  void send_message(const char* data, size_t length);
+  /**
+   * Receive a message into buffer, keeping its capacity. Throws EncodingError if the message
+   * is larger than MAX_MESSAGE_SIZE.
+   */
+  void receive_message(std::string& buffer);
+};
+
+inline void Connection::send_message(const google::protobuf::Message& message,
+                                     std::string& buffer) {
+  size_t size = message.ByteSizeLong();
+  buffer.resize(size);
+  if (size > 0)
+    message.SerializeWithCachedSizesToArray(reinterpret_cast<google::protobuf::uint8*>(&buffer[0]));
+  send_message(buffer.data(), size);
+}
+
+inline void Connection::send_message(const char* data, size_t length) {
+  google::protobuf::uint8 header[10];
+  google::protobuf::uint8* end = google::protobuf::io::CodedOutputStream::WriteVarint64ToArray(
+    length, header);
+  std::array<asio::const_buffer, 2> buffers = {{
+    asio::buffer(header, end - header), asio::buffer(data, length)}};
+  asio::error_code error;
+  asio::write(socket, buffers, error);
+  if (error)
+    throw ConnectionError(error.message());
+}
+
+template <typename Socket>
+inline void set_socket_options(Socket& socket, const ConnectionOptions& options) {
+  asio::error_code error;
+  socket.set_option(asio::ip::tcp::no_delay(options.no_delay), error);
+  if (!error && options.send_buffer_size > 0)
+    socket.set_option(asio::socket_base::send_buffer_size(options.send_buffer_size), error);
+  if (!error && options.receive_buffer_size > 0)
+    socket.set_option(asio::socket_base::receive_buffer_size(options.receive_buffer_size), error);
+#ifdef __linux__
+#ifdef SO_BUSY_POLL
+  if (!error && options.busy_poll > 0 &&
+      setsockopt(socket.native_handle(), SOL_SOCKET, SO_BUSY_POLL, &options.busy_poll,
+                 sizeof(options.busy_poll)))
+    error = asio::error_code(errno, asio::error::get_system_category());
+#endif
+#endif
+  if (error)
+    throw ConnectionError("Failed to set socket options: " + error.message());
+}
+
+inline void Connection::set_options(const ConnectionOptions& options) {
+  set_socket_options(socket, options);
+}
+
+inline void Connection::receive_message(std::string& buffer) {
+  google::protobuf::uint64 size = 0;
+  for (int shift = 0; ; shift += 7) {
+    if (shift >= 64)
+      throw EncodingError("Failed to decode message size");
+    google::protobuf::uint8 byte;
+    asio::error_code error;
+    asio::read(socket, asio::buffer(&byte, 1), error);
+    if (error)
+      throw ConnectionError(error.message());
+    size |= static_cast<google::protobuf::uint64>(byte & 0x7f) << shift;
+    if (!(byte & 0x80))
+      break;
+  }
+  if (size > MAX_MESSAGE_SIZE)
+    throw EncodingError("Message size " + std::to_string(size) + " exceeds the maximum of " +
+                        std::to_string(MAX_MESSAGE_SIZE));
+  buffer.resize(size);
+  if (size == 0)
+    return;
+  asio::error_code error;
+  asio::read(socket, asio::buffer(&buffer[0], size), error);
+  if (error)
+    throw ConnectionError(error.message());
+}
+
+inline void Transport::send_message(const google::protobuf::Message& message,
+                                    std::string& buffer) {
+  size_t size = message.ByteSizeLong();
+  buffer.resize(size);
+  if (size > 0)
+    message.SerializeWithCachedSizesToArray(reinterpret_cast<google::protobuf::uint8*>(&buffer[0]));
+  send_message(buffer.data(), size);
+}
+
+inline void Transport::send_message(const char* data, size_t length) {
+  google::protobuf::uint8 prefix[10];
+  google::protobuf::uint8* end =
+    google::protobuf::io::CodedOutputStream::WriteVarint64ToArray(length, prefix);
+  send(reinterpret_cast<const char*>(prefix), end - prefix, data, length);
+}
+
+inline void Transport::receive_message(std::string& buffer) {
+  google::protobuf::uint64 size = 0;
+  for (int shift = 0; ; shift += 7) {
+    if (shift >= 64)
+      throw EncodingError("Failed to decode message size");
+    char byte;
+    receive(&byte, 1);
+    size |= static_cast<google::protobuf::uint64>(byte & 0x7f) << shift;
+    if (!(byte & 0x80))
+      break;
+  }
+  if (size > MAX_MESSAGE_SIZE)
+    throw EncodingError("Message size " + std::to_string(size) + " exceeds the maximum of " +
+                        std::to_string(MAX_MESSAGE_SIZE));
+  buffer.resize(size);
+  if (size > 0)
+    receive(&buffer[0], size);
+}
+
 }  // namespace krpc
@@ -0,0 +1,178 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>  // NOLINT(build/c++11)
+#include <utility>
+#include <vector>
+
+namespace krpc {
+
+class Connection;
+
+/**
+ * Associates a value with each RPC connection, so that it is shared by all clients that
+ * use the connection. Connection is compiled into the library, so state that is added to
+ * it by the headers is kept here instead. A value is dropped once its connection has been
+ * destroyed.
+ *
+ * get() is called on the hot path of every procedure call, so it avoids taking a lock:
+ * while the registry is empty it checks one atomic counter, and otherwise each thread
+ * caches the result of its last lookup until the registry is next changed.
+ */
+template <typename T>
+class ConnectionRegistry {
+ public:
+  typedef std::function<std::shared_ptr<T>()> Factory;
+  ConnectionRegistry();
+  /** Whether no connection that is still open has a value. */
+  bool empty();
+  /** Returns the value of a connection, or nullptr if it has none. */
+  std::shared_ptr<T> get(const std::shared_ptr<Connection>& connection);
+  /** Returns the value of a connection, setting it to the result of create if it has none. */
+  std::shared_ptr<T> get(const std::shared_ptr<Connection>& connection, const Factory& create);
+  /** Set the value of a connection. Pass nullptr to remove it. */
+  void set(const std::shared_ptr<Connection>& connection, const std::shared_ptr<T>& value);
+
+ private:
+  ConnectionRegistry(const ConnectionRegistry&) = delete;
+  ConnectionRegistry& operator=(const ConnectionRegistry&) = delete;
+  typedef std::map<const Connection*,
+                   std::pair<std::weak_ptr<Connection>, std::shared_ptr<T>>> Entries;
+  /** The result of a thread's last lookup, valid while the generation is unchanged */
+  struct Cache {
+    Cache() : registry(nullptr), key(nullptr), generation(0) {}
+    const ConnectionRegistry * registry;
+    const Connection * key;
+    size_t generation;
+    std::weak_ptr<Connection> connection;
+    std::weak_ptr<T> value;
+  };
+  static Cache& cache();
+  std::shared_ptr<T> find(const std::shared_ptr<Connection>& connection,
+                          std::vector<std::shared_ptr<T>>& removed);
+  /**
+   * Remove the values of connections that have been destroyed. The values are moved into
+   * removed, so that they are destroyed after the lock is released. Requires the lock.
+   */
+  void purge(std::vector<std::shared_ptr<T>>& removed);
+  void changed();
+  std::mutex lock;
+  Entries entries;
+  /** Number of entries, read without the lock */
+  std::atomic<size_t> size;
+  /** Incremented whenever the entries change, to invalidate the threads' caches */
+  std::atomic<size_t> generation;
+};
+
+template <typename T> inline ConnectionRegistry<T>::ConnectionRegistry() :
+  size(0), generation(1) {
+}
+
+template <typename T> inline bool ConnectionRegistry<T>::empty() {
+  if (size.load(std::memory_order_acquire) == 0)
+    return true;
+  std::vector<std::shared_ptr<T>> removed;
+  std::lock_guard<std::mutex> guard(lock);
+  purge(removed);
+  return entries.empty();
+}
+
+template <typename T> inline std::shared_ptr<T> ConnectionRegistry<T>::get(
+  const std::shared_ptr<Connection>& connection) {
+  if (size.load(std::memory_order_acquire) == 0)
+    return nullptr;
+  Cache& cached = cache();
+  if (cached.registry == this && cached.key == connection.get() &&
+      cached.generation == generation.load(std::memory_order_acquire)) {
+    if (cached.value.expired())
+      return nullptr;
+    // A connection at the address of one that was destroyed is a different connection
+    std::shared_ptr<T> value = cached.value.lock();
+    if (value && !cached.connection.expired())
+      return value;
+  }
+  std::vector<std::shared_ptr<T>> removed;
+  std::lock_guard<std::mutex> guard(lock);
+  return find(connection, removed);
+}
+
+template <typename T> inline std::shared_ptr<T> ConnectionRegistry<T>::get(
+  const std::shared_ptr<Connection>& connection, const Factory& create) {
+  std::shared_ptr<T> value = get(connection);
+  if (value)
+    return value;
+  std::vector<std::shared_ptr<T>> removed;
+  std::lock_guard<std::mutex> guard(lock);
+  value = find(connection, removed);
+  if (value)
+    return value;
+  value = create();
+  entries[connection.get()] = std::make_pair(std::weak_ptr<Connection>(connection), value);
+  changed();
+  return value;
+}
+
+template <typename T> inline void ConnectionRegistry<T>::set(
+  const std::shared_ptr<Connection>& connection, const std::shared_ptr<T>& value) {
+  std::vector<std::shared_ptr<T>> removed;
+  std::lock_guard<std::mutex> guard(lock);
+  purge(removed);
+  auto it = entries.find(connection.get());
+  if (it != entries.end()) {
+    removed.push_back(std::move(it->second.second));
+    entries.erase(it);
+  }
+  if (value)
+    entries[connection.get()] = std::make_pair(std::weak_ptr<Connection>(connection), value);
+  changed();
+}
+
+template <typename T> inline typename ConnectionRegistry<T>::Cache&
+ConnectionRegistry<T>::cache() {
+  static thread_local Cache cache;
+  return cache;
+}
+
+template <typename T> inline std::shared_ptr<T> ConnectionRegistry<T>::find(
+  const std::shared_ptr<Connection>& connection, std::vector<std::shared_ptr<T>>& removed) {
+  std::shared_ptr<T> value;
+  auto it = entries.find(connection.get());
+  if (it != entries.end() && !it->second.first.expired())
+    value = it->second.second;
+  else
+    purge(removed);
+  Cache& cached = cache();
+  cached.registry = this;
+  cached.key = connection.get();
+  cached.generation = generation.load(std::memory_order_relaxed);
+  cached.connection = connection;
+  cached.value = value;
+  return value;
+}
+
+template <typename T> inline void ConnectionRegistry<T>::purge(
+  std::vector<std::shared_ptr<T>>& removed) {
+  bool purged = false;
+  for (auto it = entries.begin(); it != entries.end();) {
+    if (it->second.first.expired()) {
+      removed.push_back(std::move(it->second.second));
+      it = entries.erase(it);
+      purged = true;
+    } else {
+      ++it;
+    }
+  }
+  if (purged)
+    changed();
+}
+
+template <typename T> inline void ConnectionRegistry<T>::changed() {
+  size.store(entries.size(), std::memory_order_release);
+  generation.fetch_add(1, std::memory_order_release);
+}
+
+}  // namespace krpc
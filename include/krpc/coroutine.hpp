@@ -0,0 +1,247 @@
+#pragma once
+
+#if !defined(__cpp_impl_coroutine) || !__has_include(<coroutine>)
+#error "krpc/coroutine.hpp requires C++20 coroutine support"
+#endif
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>  // NOLINT(build/c++11)
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "krpc/client.hpp"
+#include "krpc/connection.hpp"
+#include "krpc/future.hpp"
+
+namespace krpc {
+
+template <typename T> class Task;
+
+/**
+ * Runs coroutines on a single thread, using the io_service of a client's RPC connection.
+ * Coroutines that co_await the result of an *_async() call are suspended until the
+ * response is received, and are then resumed by run(), so one thread can drive any
+ * number of sequential chains of procedure calls without blocking.
+ */
+class CoroutineExecutor {
+ public:
+  explicit CoroutineExecutor(Client * client);
+  /** Start a coroutine. It first runs when run() is called. */
+  void spawn(Task<void> task);
+  /**
+   * Run coroutines on the calling thread until all spawned coroutines have finished.
+   * Rethrows the first exception that escaped a spawned coroutine.
+   */
+  void run();
+  /** Resume a coroutine on the thread that is calling run(). */
+  void post(std::coroutine_handle<> handle);
+  /** Returns the executor that is running on the calling thread, or nullptr. */
+  static CoroutineExecutor * current();
+
+ private:
+  struct Detached;
+  static CoroutineExecutor *& current_executor();
+  static Detached run_detached(CoroutineExecutor * executor, Task<void> task);
+  void finished(const std::exception_ptr& exception);
+  std::shared_ptr<Connection> connection;
+  asio::io_service& io_service;
+  std::unique_ptr<asio::io_service::work> work;
+  std::mutex lock;
+  size_t tasks;
+  std::exception_ptr exception;
+};
+
+/**
+ * A coroutine returning a value of type T. Tasks do not start until they are
+ * awaited, or are spawned on a CoroutineExecutor.
+ */
+template <typename T>
+class Task {
+ public:
+  struct promise_type;
+  typedef std::coroutine_handle<promise_type> Handle;
+
+  struct FinalAwaiter {
+    bool await_ready() const noexcept { return false; }
+    std::coroutine_handle<> await_suspend(Handle handle) noexcept {
+      std::coroutine_handle<> continuation = handle.promise().continuation;
+      if (continuation)
+        return continuation;
+      return std::noop_coroutine();
+    }
+    void await_resume() const noexcept {}
+  };
+
+  struct PromiseBase {
+    std::coroutine_handle<> continuation;
+    std::exception_ptr exception;
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    FinalAwaiter final_suspend() const noexcept { return {}; }
+    void unhandled_exception() { exception = std::current_exception(); }
+  };
+
+  struct ValuePromise : PromiseBase {
+    T value;
+    void return_value(T value) { this->value = std::move(value); }
+    T result() {
+      if (this->exception)
+        std::rethrow_exception(this->exception);
+      return std::move(value);
+    }
+  };
+
+  struct VoidPromise : PromiseBase {
+    void return_void() {}
+    void result() {
+      if (this->exception)
+        std::rethrow_exception(this->exception);
+    }
+  };
+
+  struct promise_type : std::conditional<std::is_void<T>::value, VoidPromise, ValuePromise>::type {
+    Task get_return_object() { return Task(Handle::from_promise(*this)); }
+  };
+
+  Task() : handle(nullptr) {}
+  explicit Task(Handle handle) : handle(handle) {}
+  Task(Task&& other) noexcept : handle(other.handle) { other.handle = nullptr; }
+  Task& operator=(Task&& other) noexcept {
+    if (this != &other) {
+      if (handle)
+        handle.destroy();
+      handle = other.handle;
+      other.handle = nullptr;
+    }
+    return *this;
+  }
+  Task(const Task&) = delete;
+  Task& operator=(const Task&) = delete;
+  ~Task() {
+    if (handle)
+      handle.destroy();
+  }
+
+  /** Throws std::logic_error if the task is empty, such as when it has been moved from. */
+  bool await_ready() const {
+    if (!handle)
+      throw std::logic_error("Awaited a task that has no coroutine");
+    return handle.done();
+  }
+  std::coroutine_handle<> await_suspend(std::coroutine_handle<> continuation) noexcept {
+    handle.promise().continuation = continuation;
+    return handle;
+  }
+  T await_resume() { return handle.promise().result(); }
+
+ private:
+  Handle handle;
+};
+
+/** Suspends a coroutine until the result of an asynchronous call has been received. */
+template <typename T>
+class FutureAwaiter {
+ public:
+  explicit FutureAwaiter(Future<T> future) : future(std::move(future)), executor(nullptr) {}
+  bool await_ready() {
+    // Outside of an executor there is nothing to resume the coroutine, so block instead
+    executor = CoroutineExecutor::current();
+    return !executor || future.is_ready();
+  }
+  void await_suspend(std::coroutine_handle<> handle) {
+    CoroutineExecutor * executor = this->executor;
+    future.set_callback([executor, handle] { executor->post(handle); });
+  }
+  T await_resume() { return future.get(); }
+
+ private:
+  Future<T> future;
+  CoroutineExecutor * executor;
+};
+
+template <typename T> inline FutureAwaiter<T> operator co_await(Future<T> future) {
+  return FutureAwaiter<T>(std::move(future));
+}
+
+struct CoroutineExecutor::Detached {
+  struct promise_type {
+    Detached get_return_object() {
+      return Detached{std::coroutine_handle<promise_type>::from_promise(*this)};
+    }
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    std::suspend_never final_suspend() const noexcept { return {}; }
+    void return_void() {}
+    void unhandled_exception() { std::terminate(); }
+  };
+  std::coroutine_handle<promise_type> handle;
+};
+
+inline CoroutineExecutor::CoroutineExecutor(Client * client) :
+  connection(client->rpc_connection), io_service(connection->io_service), tasks(0) {
+}
+
+inline void CoroutineExecutor::spawn(Task<void> task) {
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    if (tasks++ == 0)
+      work.reset(new asio::io_service::work(io_service));
+  }
+  post(run_detached(this, std::move(task)).handle);
+}
+
+inline void CoroutineExecutor::run() {
+  CoroutineExecutor * previous = current_executor();
+  current_executor() = this;
+  try {
+    io_service.reset();
+    io_service.run();
+  } catch (...) {
+    current_executor() = previous;
+    throw;
+  }
+  current_executor() = previous;
+  std::exception_ptr exception;
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    exception.swap(this->exception);
+  }
+  if (exception)
+    std::rethrow_exception(exception);
+}
+
+inline void CoroutineExecutor::post(std::coroutine_handle<> handle) {
+  io_service.post([handle] { handle.resume(); });
+}
+
+inline CoroutineExecutor * CoroutineExecutor::current() {
+  return current_executor();
+}
+
+inline CoroutineExecutor *& CoroutineExecutor::current_executor() {
+  static thread_local CoroutineExecutor * executor = nullptr;
+  return executor;
+}
+
+inline CoroutineExecutor::Detached CoroutineExecutor::run_detached(
+  CoroutineExecutor * executor, Task<void> task) {
+  std::exception_ptr exception;
+  try {
+    co_await task;
+  } catch (...) {
+    exception = std::current_exception();
+  }
+  executor->finished(exception);
+}
+
+inline void CoroutineExecutor::finished(const std::exception_ptr& exception) {
+  std::lock_guard<std::mutex> guard(lock);
+  if (exception && !this->exception)
+    this->exception = exception;
+  if (--tasks == 0)
+    work.reset();
+}
+
+}  // namespace krpc
@@ -1,14 +1,18 @@
 #pragma once
 
+#include <google/protobuf/io/coded_stream.h>
 #include <google/protobuf/stubs/port.h>
+#include <google/protobuf/wire_format_lite.h>
 
 #include <cstddef>
 #include <map>
 #include <set>
 #include <string>
 #include <tuple>
+#include <type_traits>
 #include <vector>
 
+#include "krpc/error.hpp"
 #include "krpc/krpc.pb.hpp"
 
 namespace google {
@@ -43,6 +47,14 @@ void decode(google::protobuf::Message& message, const std::string& data, Client
 template <typename T> void decode(Object<T>& object, const std::string& data,
                                   Client * client = nullptr);
 
+/**
+ * Decode an enumeration, which is encoded as its integer value. The services also declare
+ * a decoder for each of their enumerations, but after this header, so template code such
+ * as Stream<T> only finds this one.
+ */
+template <typename T> typename std::enable_if<std::is_enum<T>::value>::type decode(
+  T& value, const std::string& data, Client * client = nullptr);
+
 template <typename T0> void decode(
   std::tuple<T0>& tuple, const std::string& data, Client * client = nullptr);
 template <typename T0, typename T1> void decode(
@@ -63,6 +75,76 @@ template <typename K, typename V> void decode(
 
 google::protobuf::uint32 decode_size(const std::string& data);
 
+/*
+ * Decode a value directly from a buffer, without copying it into a std::string
+ * or parsing intermediate protobuf messages. Types without a specialized decoder
+ * fall back to the std::string overloads.
+ */
+template <typename T> void decode(T& value, const char* data, size_t size,
+                                  Client * client = nullptr);
+void decode(double& value, const char* data, size_t size, Client * client = nullptr);
+void decode(float& value, const char* data, size_t size, Client * client = nullptr);
+void decode(google::protobuf::int32& value, const char* data, size_t size,
+            Client * client = nullptr);
+void decode(google::protobuf::int64& value, const char* data, size_t size,
+            Client * client = nullptr);
+void decode(google::protobuf::uint32& value, const char* data, size_t size,
+            Client * client = nullptr);
+void decode(google::protobuf::uint64& value, const char* data, size_t size,
+            Client * client = nullptr);
+void decode(bool& value, const char* data, size_t size, Client * client = nullptr);
+void decode(std::string& value, const char* data, size_t size, Client * client = nullptr);
+
+template <typename T> void decode(Object<T>& object, const char* data, size_t size,
+                                  Client * client = nullptr);
+
+template <typename T0> void decode(
+  std::tuple<T0>& tuple, const char* data, size_t size, Client * client = nullptr);
+template <typename T0, typename T1> void decode(
+  std::tuple<T0, T1>& tuple, const char* data, size_t size, Client * client = nullptr);
+template <typename T0, typename T1, typename T2> void decode(
+  std::tuple<T0, T1, T2>& tuple, const char* data, size_t size, Client * client = nullptr);
+template <typename T0, typename T1, typename T2, typename T3> void decode(
+  std::tuple<T0, T1, T2, T3>& tuple, const char* data, size_t size, Client * client = nullptr);
+template <typename T0, typename T1, typename T2, typename T3, typename T4> void decode(
+  std::tuple<T0, T1, T2, T3, T4>& tuple, const char* data, size_t size,
+  Client * client = nullptr);
+
+/**
+ * Tuples of doubles, such as vectors and quaternions, are decoded without parsing when
+ * they have the layout that the server encodes them with. Other layouts fall back to the
+ * templates above.
+ */
+void decode(std::tuple<double, double>& tuple, const char* data, size_t size,
+            Client * client = nullptr);
+void decode(std::tuple<double, double, double>& tuple, const char* data, size_t size,
+            Client * client = nullptr);
+void decode(std::tuple<double, double, double, double>& tuple, const char* data, size_t size,
+            Client * client = nullptr);
+/**
+ * Decode a Tuple message holding count doubles, if each item is a tag, a length of 8 and
+ * the value. Returns false, without changing the values, if the data has another layout.
+ */
+bool decode_doubles(double* values, size_t count, const char* data, size_t size);
+
+template <typename T> void decode(std::vector<T>& list, const char* data, size_t size,
+                                  Client * client = nullptr);
+template <typename T> void decode(std::set<T>& set, const char* data, size_t size,
+                                  Client * client = nullptr);
+template <typename K, typename V> void decode(
+  std::map<K, V>& dictionary, const char* data, size_t size, Client * client = nullptr);
+
+/**
+ * Read the next length-delimited field of a message, skipping fields of other wire types.
+ * Sets data to point at the field's contents in the underlying buffer.
+ * Returns false at the end of the message.
+ */
+bool read_field(google::protobuf::io::CodedInputStream& input, int& field,
+                const char*& data, size_t& size);
+/** Read the next item of a List, Set or Tuple message, and decode it. */
+template <typename T> void decode_item(T& value, google::protobuf::io::CodedInputStream& input,
+                                       Client * client);
+
 template <typename T>
 inline void decode(Object<T>& object, const std::string& data, Client * client) {
   google::protobuf::uint64 id;
@@ -71,90 +153,335 @@ inline void decode(Object<T>& object, const std::string& data, Client * client)
   object._id = id;
 }
 
+template <typename T> inline typename std::enable_if<std::is_enum<T>::value>::type decode(
+  T& value, const std::string& data, Client * client) {
+  google::protobuf::int32 x;
+  decode(x, data, client);
+  value = static_cast<T>(x);
+}
+
 template <typename T0>
 inline void decode(std::tuple<T0>& tuple, const std::string& data, Client * client) {
-  krpc::schema::Tuple tupleMessage;
-  tupleMessage.ParseFromString(data);
-  decode(std::get<0>(tuple), tupleMessage.items(0), client);
+  decode(tuple, data.data(), data.size(), client);
 }
 
 template <typename T0, typename T1>
 inline void decode(std::tuple<T0, T1>& tuple, const std::string& data, Client * client) {
-  krpc::schema::Tuple tupleMessage;
-  tupleMessage.ParseFromString(data);
-  decode(std::get<0>(tuple), tupleMessage.items(0), client);
-  decode(std::get<1>(tuple), tupleMessage.items(1), client);
+  decode(tuple, data.data(), data.size(), client);
 }
 
 template <typename T0, typename T1, typename T2>
 inline void decode(std::tuple<T0, T1, T2>& tuple, const std::string& data, Client * client) {
-  krpc::schema::Tuple tupleMessage;
-  tupleMessage.ParseFromString(data);
-  decode(std::get<0>(tuple), tupleMessage.items(0), client);
-  decode(std::get<1>(tuple), tupleMessage.items(1), client);
-  decode(std::get<2>(tuple), tupleMessage.items(2), client);
+  decode(tuple, data.data(), data.size(), client);
 }
 
 template <typename T0, typename T1, typename T2, typename T3>
 inline void decode(std::tuple<T0, T1, T2, T3>& tuple, const std::string& data, Client * client) {
-  krpc::schema::Tuple tupleMessage;
-  tupleMessage.ParseFromString(data);
-  decode(std::get<0>(tuple), tupleMessage.items(0), client);
-  decode(std::get<1>(tuple), tupleMessage.items(1), client);
-  decode(std::get<2>(tuple), tupleMessage.items(2), client);
-  decode(std::get<3>(tuple), tupleMessage.items(3), client);
+  decode(tuple, data.data(), data.size(), client);
 }
 
 template <typename T0, typename T1, typename T2, typename T3, typename T4>
 inline void decode(std::tuple<T0, T1, T2, T3, T4>& tuple, const std::string& data,
                    Client * client) {
-  krpc::schema::Tuple tupleMessage;
-  tupleMessage.ParseFromString(data);
-  decode(std::get<0>(tuple), tupleMessage.items(0), client);
-  decode(std::get<1>(tuple), tupleMessage.items(1), client);
-  decode(std::get<2>(tuple), tupleMessage.items(2), client);
-  decode(std::get<3>(tuple), tupleMessage.items(3), client);
-  decode(std::get<4>(tuple), tupleMessage.items(4), client);
+  decode(tuple, data.data(), data.size(), client);
 }
 
 template <typename T>
 inline void decode(std::vector<T>& list, const std::string& data, Client * client) {
+  decode(list, data.data(), data.size(), client);
+}
+
+template <typename T> inline void decode(std::set<T>& set, const std::string& data,
+                                         Client * client) {
+  decode(set, data.data(), data.size(), client);
+}
+
+template <typename K, typename V> inline void decode(
+  std::map<K, V>& dictionary, const std::string& data, Client * client) {
+  decode(dictionary, data.data(), data.size(), client);
+}
+
+template <typename T>
+inline void decode(T& value, const char* data, size_t size, Client * client) {
+  decode(value, std::string(data, size), client);
+}
+
+inline void decode(double& value, const char* data, size_t size, Client *) {
+  google::protobuf::io::CodedInputStream input(
+    reinterpret_cast<const google::protobuf::uint8*>(data), static_cast<int>(size));
+  google::protobuf::uint64 x;
+  if (!input.ReadLittleEndian64(&x))
+    throw EncodingError("Failed to decode double");
+  value = google::protobuf::internal::WireFormatLite::DecodeDouble(x);
+}
+
+inline void decode(float& value, const char* data, size_t size, Client *) {
+  google::protobuf::io::CodedInputStream input(
+    reinterpret_cast<const google::protobuf::uint8*>(data), static_cast<int>(size));
+  google::protobuf::uint32 x;
+  if (!input.ReadLittleEndian32(&x))
+    throw EncodingError("Failed to decode float");
+  value = google::protobuf::internal::WireFormatLite::DecodeFloat(x);
+}
+
+inline void decode(google::protobuf::int32& value, const char* data, size_t size, Client *) {
+  google::protobuf::io::CodedInputStream input(
+    reinterpret_cast<const google::protobuf::uint8*>(data), static_cast<int>(size));
+  google::protobuf::uint32 x;
+  if (!input.ReadVarint32(&x))
+    throw EncodingError("Failed to decode int32");
+  value = google::protobuf::internal::WireFormatLite::ZigZagDecode32(x);
+}
+
+inline void decode(google::protobuf::int64& value, const char* data, size_t size, Client *) {
+  google::protobuf::io::CodedInputStream input(
+    reinterpret_cast<const google::protobuf::uint8*>(data), static_cast<int>(size));
+  google::protobuf::uint64 x;
+  if (!input.ReadVarint64(&x))
+    throw EncodingError("Failed to decode int64");
+  value = google::protobuf::internal::WireFormatLite::ZigZagDecode64(x);
+}
+
+inline void decode(google::protobuf::uint32& value, const char* data, size_t size, Client *) {
+  google::protobuf::io::CodedInputStream input(
+    reinterpret_cast<const google::protobuf::uint8*>(data), static_cast<int>(size));
+  if (!input.ReadVarint32(&value))
+    throw EncodingError("Failed to decode uint32");
+}
+
+inline void decode(google::protobuf::uint64& value, const char* data, size_t size, Client *) {
+  google::protobuf::io::CodedInputStream input(
+    reinterpret_cast<const google::protobuf::uint8*>(data), static_cast<int>(size));
+  if (!input.ReadVarint64(&value))
+    throw EncodingError("Failed to decode uint64");
+}
+
+inline void decode(bool& value, const char* data, size_t size, Client *) {
+  google::protobuf::io::CodedInputStream input(
+    reinterpret_cast<const google::protobuf::uint8*>(data), static_cast<int>(size));
+  google::protobuf::uint64 x;
+  if (!input.ReadVarint64(&x))
+    throw EncodingError("Failed to decode bool");
+  value = x != 0;
+}
+
+inline void decode(std::string& value, const char* data, size_t size, Client *) {
+  google::protobuf::io::CodedInputStream input(
+    reinterpret_cast<const google::protobuf::uint8*>(data), static_cast<int>(size));
+  google::protobuf::uint32 length;
+  if (!input.ReadVarint32(&length) || !input.ReadString(&value, length))
+    throw EncodingError("Failed to decode string");
+}
+
+template <typename T>
+inline void decode(Object<T>& object, const char* data, size_t size, Client * client) {
+  google::protobuf::uint64 id;
+  decode(id, data, size, client);
+  object._client = client;
+  object._id = id;
+}
+
+template <typename T0>
+inline void decode(std::tuple<T0>& tuple, const char* data, size_t size, Client * client) {
+  google::protobuf::io::CodedInputStream input(
+    reinterpret_cast<const google::protobuf::uint8*>(data), static_cast<int>(size));
+  decode_item(std::get<0>(tuple), input, client);
+}
+
+template <typename T0, typename T1>
+inline void decode(std::tuple<T0, T1>& tuple, const char* data, size_t size, Client * client) {
+  google::protobuf::io::CodedInputStream input(
+    reinterpret_cast<const google::protobuf::uint8*>(data), static_cast<int>(size));
+  decode_item(std::get<0>(tuple), input, client);
+  decode_item(std::get<1>(tuple), input, client);
+}
+
+template <typename T0, typename T1, typename T2>
+inline void decode(std::tuple<T0, T1, T2>& tuple, const char* data, size_t size,
+                   Client * client) {
+  google::protobuf::io::CodedInputStream input(
+    reinterpret_cast<const google::protobuf::uint8*>(data), static_cast<int>(size));
+  decode_item(std::get<0>(tuple), input, client);
+  decode_item(std::get<1>(tuple), input, client);
+  decode_item(std::get<2>(tuple), input, client);
+}
+
+template <typename T0, typename T1, typename T2, typename T3>
+inline void decode(std::tuple<T0, T1, T2, T3>& tuple, const char* data, size_t size,
+                   Client * client) {
+  google::protobuf::io::CodedInputStream input(
+    reinterpret_cast<const google::protobuf::uint8*>(data), static_cast<int>(size));
+  decode_item(std::get<0>(tuple), input, client);
+  decode_item(std::get<1>(tuple), input, client);
+  decode_item(std::get<2>(tuple), input, client);
+  decode_item(std::get<3>(tuple), input, client);
+}
+
+template <typename T0, typename T1, typename T2, typename T3, typename T4>
+inline void decode(std::tuple<T0, T1, T2, T3, T4>& tuple, const char* data, size_t size,
+                   Client * client) {
+  google::protobuf::io::CodedInputStream input(
+    reinterpret_cast<const google::protobuf::uint8*>(data), static_cast<int>(size));
+  decode_item(std::get<0>(tuple), input, client);
+  decode_item(std::get<1>(tuple), input, client);
+  decode_item(std::get<2>(tuple), input, client);
+  decode_item(std::get<3>(tuple), input, client);
+  decode_item(std::get<4>(tuple), input, client);
+}
+
+inline void decode(std::tuple<double, double>& tuple, const char* data, size_t size,
+                   Client * client) {
+  double values[2];
+  if (!decode_doubles(values, 2, data, size))
+    return decode<double, double>(tuple, data, size, client);
+  tuple = std::make_tuple(values[0], values[1]);
+}
+
+inline void decode(std::tuple<double, double, double>& tuple, const char* data, size_t size,
+                   Client * client) {
+  double values[3];
+  if (!decode_doubles(values, 3, data, size))
+    return decode<double, double, double>(tuple, data, size, client);
+  tuple = std::make_tuple(values[0], values[1], values[2]);
+}
+
+inline void decode(std::tuple<double, double, double, double>& tuple, const char* data,
+                   size_t size, Client * client) {
+  double values[4];
+  if (!decode_doubles(values, 4, data, size))
+    return decode<double, double, double, double>(tuple, data, size, client);
+  tuple = std::make_tuple(values[0], values[1], values[2], values[3]);
+}
+
+inline bool decode_doubles(double* values, size_t count, const char* data, size_t size) {
+  typedef google::protobuf::internal::WireFormatLite WireFormatLite;
+  const size_t item_size = 2 + sizeof(google::protobuf::uint64);
+  const char tag = static_cast<char>(
+    WireFormatLite::MakeTag(1, WireFormatLite::WIRETYPE_LENGTH_DELIMITED));
+  if (size != count * item_size)
+    return false;
+  for (size_t i = 0; i < count; i++) {
+    if (data[i * item_size] != tag || data[i * item_size + 1] != sizeof(google::protobuf::uint64))
+      return false;
+  }
+  // Compiles to unaligned loads, with a byte swap on big endian platforms
+  for (size_t i = 0; i < count; i++) {
+    google::protobuf::uint64 bits;
+    google::protobuf::io::CodedInputStream::ReadLittleEndian64FromArray(
+      reinterpret_cast<const google::protobuf::uint8*>(data + i * item_size + 2), &bits);
+    values[i] = WireFormatLite::DecodeDouble(bits);
+  }
+  return true;
+}
+
+template <typename T>
+inline void decode(std::vector<T>& list, const char* data, size_t size, Client * client) {
   list.clear();
-  krpc::schema::List listMessage;
-  listMessage.ParseFromString(data);
-  for (int i = 0; i < listMessage.items_size(); i++) {
+  google::protobuf::io::CodedInputStream input(
+    reinterpret_cast<const google::protobuf::uint8*>(data), static_cast<int>(size));
+  int field;
+  const char* item;
+  size_t item_size;
+  while (read_field(input, field, item, item_size)) {
+    if (field != 1)
+      continue;
     T value;
-    decode(value, listMessage.items(i), client);
+    decode(value, item, item_size, client);
     list.push_back(value);
   }
 }
 
-template <typename T> inline void decode(std::set<T>& set, const std::string& data,
-                                         Client * client) {
+template <typename T>
+inline void decode(std::set<T>& set, const char* data, size_t size, Client * client) {
   set.clear();
-  krpc::schema::Set setMessage;
-  setMessage.ParseFromString(data);
-  for (int i = 0; i < setMessage.items_size(); i++) {
+  google::protobuf::io::CodedInputStream input(
+    reinterpret_cast<const google::protobuf::uint8*>(data), static_cast<int>(size));
+  int field;
+  const char* item;
+  size_t item_size;
+  while (read_field(input, field, item, item_size)) {
+    if (field != 1)
+      continue;
     T value;
-    decode(value, setMessage.items(i), client);
+    decode(value, item, item_size, client);
     set.insert(value);
   }
 }
 
 template <typename K, typename V> inline void decode(
-  std::map<K, V>& dictionary, const std::string& data, Client * client) {
+  std::map<K, V>& dictionary, const char* data, size_t size, Client * client) {
   dictionary.clear();
-  krpc::schema::Dictionary dictionaryMessage;
-  dictionaryMessage.ParseFromString(data);
-  for (int i = 0; i < dictionaryMessage.entries_size(); i++) {
-    const schema::DictionaryEntry& entry = dictionaryMessage.entries(i);
-    K key;
-    V value;
-    decode(key, entry.key(), client);
-    decode(value, entry.value(), client);
-    dictionary[key] = value;
+  google::protobuf::io::CodedInputStream input(
+    reinterpret_cast<const google::protobuf::uint8*>(data), static_cast<int>(size));
+  int field;
+  const char* entry;
+  size_t entry_size;
+  while (read_field(input, field, entry, entry_size)) {
+    if (field != 1)
+      continue;
+    google::protobuf::io::CodedInputStream entry_input(
+      reinterpret_cast<const google::protobuf::uint8*>(entry), static_cast<int>(entry_size));
+    // Empty keys and values are omitted from the entry
+    const char* key = "";
+    size_t key_size = 0;
+    const char* value = "";
+    size_t value_size = 0;
+    const char* item;
+    size_t item_size;
+    while (read_field(entry_input, field, item, item_size)) {
+      if (field == 1) {
+        key = item;
+        key_size = item_size;
+      } else if (field == 2) {
+        value = item;
+        value_size = item_size;
+      }
+    }
+    K k;
+    decode(k, key, key_size, client);
+    decode(dictionary[k], value, value_size, client);
   }
 }
 
+inline bool read_field(google::protobuf::io::CodedInputStream& input, int& field,
+                       const char*& data, size_t& size) {
+  typedef google::protobuf::internal::WireFormatLite WireFormatLite;
+  while (true) {
+    google::protobuf::uint32 tag = input.ReadTag();
+    if (tag == 0)
+      return false;
+    if (WireFormatLite::GetTagWireType(tag) != WireFormatLite::WIRETYPE_LENGTH_DELIMITED) {
+      if (!WireFormatLite::SkipField(&input, tag))
+        throw EncodingError("Failed to decode message");
+      continue;
+    }
+    google::protobuf::uint32 length;
+    const void* buffer;
+    int available;
+    if (!input.ReadVarint32(&length))
+      throw EncodingError("Failed to decode message");
+    input.GetDirectBufferPointerInline(&buffer, &available);
+    if (static_cast<google::protobuf::uint32>(available) < length)
+      throw EncodingError("Failed to decode message");
+    field = WireFormatLite::GetTagFieldNumber(tag);
+    data = static_cast<const char*>(buffer);
+    size = length;
+    input.Skip(static_cast<int>(length));
+    return true;
+  }
+}
+
+template <typename T> inline void decode_item(
+  T& value, google::protobuf::io::CodedInputStream& input, Client * client) {
+  int field;
+  const char* item;
+  size_t size;
+  do {
+    if (!read_field(input, field, item, size))
+      throw EncodingError("Failed to decode tuple, too few items");
+  } while (field != 1);
+  decode(value, item, size, client);
+}
+
 }  // namespace decoder
 }  // namespace krpc
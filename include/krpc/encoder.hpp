@@ -1,11 +1,15 @@
 #pragma once
 
+#include <google/protobuf/io/coded_stream.h>
 #include <google/protobuf/stubs/port.h>
+#include <google/protobuf/wire_format_lite.h>
 
+#include <cstddef>
 #include <map>
 #include <set>
 #include <string>
 #include <tuple>
+#include <type_traits>
 #include <vector>
 
 #include "krpc/krpc.pb.hpp"
@@ -61,6 +65,283 @@ std::string encode(const std::tuple<T0, T1, T2, T3, T4>& tuple);
 
 std::string encode_message_with_size(const google::protobuf::Message& message);
 
+/**
+ * Encoding into a single buffer. encode_to() appends the encoding of a value to a buffer,
+ * writing the items of lists, sets, dictionaries and tuples and their size prefixes
+ * directly, rather than building a message from separately encoded items. encoded_size()
+ * returns the number of bytes that encode_to() appends, which is a constant for fixed size
+ * types. The output is identical to that of encode(), which uses them for collections.
+ */
+size_t encoded_size(float value);
+size_t encoded_size(double value);
+size_t encoded_size(google::protobuf::int32 value);
+size_t encoded_size(google::protobuf::int64 value);
+size_t encoded_size(google::protobuf::uint32 value);
+size_t encoded_size(google::protobuf::uint64 value);
+size_t encoded_size(bool value);
+size_t encoded_size(const char* value);
+size_t encoded_size(const std::string& value);
+template <typename T> size_t encoded_size(const Object<T>& object);
+template <typename T> size_t encoded_size(const std::vector<T>& list);
+template <typename K, typename V> size_t encoded_size(const std::map<K, V>& dictionary);
+template <typename T> size_t encoded_size(const std::set<T>& set);
+template <typename... Ts> size_t encoded_size(const std::tuple<Ts...>& tuple);
+/** Other types, such as messages and enumerations, are encoded using encode(). */
+template <typename T> size_t encoded_size(const T& value);
+
+void encode_to(std::string& buffer, float value);
+void encode_to(std::string& buffer, double value);
+void encode_to(std::string& buffer, google::protobuf::int32 value);
+void encode_to(std::string& buffer, google::protobuf::int64 value);
+void encode_to(std::string& buffer, google::protobuf::uint32 value);
+void encode_to(std::string& buffer, google::protobuf::uint64 value);
+void encode_to(std::string& buffer, bool value);
+void encode_to(std::string& buffer, const char* value);
+void encode_to(std::string& buffer, const std::string& value);
+template <typename T> void encode_to(std::string& buffer, const Object<T>& object);
+template <typename T> void encode_to(std::string& buffer, const std::vector<T>& list);
+template <typename K, typename V>
+void encode_to(std::string& buffer, const std::map<K, V>& dictionary);
+template <typename T> void encode_to(std::string& buffer, const std::set<T>& set);
+template <typename... Ts> void encode_to(std::string& buffer, const std::tuple<Ts...>& tuple);
+template <typename T> void encode_to(std::string& buffer, const T& value);
+
+/** Encode a value into a new string, allocated once at its encoded size. */
+template <typename T> std::string encode_direct(const T& value);
+
+inline size_t varint_size(google::protobuf::uint64 value) {
+  return google::protobuf::io::CodedOutputStream::VarintSize64(value);
+}
+
+inline void write_varint(std::string& buffer, google::protobuf::uint64 value) {
+  google::protobuf::uint8 bytes[10];
+  google::protobuf::uint8* end =
+    google::protobuf::io::CodedOutputStream::WriteVarint64ToArray(value, bytes);
+  buffer.append(reinterpret_cast<const char*>(bytes), end - bytes);
+}
+
+/** The size of an item of a collection message: its tag, size and encoded value. */
+template <typename T> inline size_t item_size(const T& value) {
+  size_t size = encoded_size(value);
+  return 1 + varint_size(size) + size;
+}
+
+/** Append an item of a collection message, in the given length delimited field. */
+template <typename T> inline void write_item(std::string& buffer, int field, const T& value) {
+  buffer += static_cast<char>(
+    google::protobuf::internal::WireFormatLite::MakeTag(
+      field, google::protobuf::internal::WireFormatLite::WIRETYPE_LENGTH_DELIMITED));
+  write_varint(buffer, encoded_size(value));
+  encode_to(buffer, value);
+}
+
+inline size_t encoded_size(float) {
+  return sizeof(google::protobuf::uint32);
+}
+
+inline size_t encoded_size(double) {
+  return sizeof(google::protobuf::uint64);
+}
+
+inline size_t encoded_size(google::protobuf::int32 value) {
+  return varint_size(google::protobuf::internal::WireFormatLite::ZigZagEncode32(value));
+}
+
+inline size_t encoded_size(google::protobuf::int64 value) {
+  return varint_size(google::protobuf::internal::WireFormatLite::ZigZagEncode64(value));
+}
+
+inline size_t encoded_size(google::protobuf::uint32 value) {
+  return varint_size(value);
+}
+
+inline size_t encoded_size(google::protobuf::uint64 value) {
+  return varint_size(value);
+}
+
+inline size_t encoded_size(bool) {
+  return 1;
+}
+
+inline size_t encoded_size(const char* value) {
+  size_t length = std::char_traits<char>::length(value);
+  return varint_size(length) + length;
+}
+
+inline size_t encoded_size(const std::string& value) {
+  return varint_size(value.size()) + value.size();
+}
+
+template <typename T> inline size_t encoded_size(const Object<T>& object) {
+  return encoded_size(object._id);
+}
+
+template <typename T> inline size_t encoded_size(const std::vector<T>& list) {
+  size_t size = 0;
+  for (auto& item : list)
+    size += item_size(item);
+  return size;
+}
+
+template <typename K, typename V>
+inline size_t encoded_size(const std::map<K, V>& dictionary) {
+  size_t size = 0;
+  for (auto& entry : dictionary) {
+    // Empty keys and values are the defaults of their fields, so are not written
+    size_t key = encoded_size(entry.first);
+    size_t value = encoded_size(entry.second);
+    size_t entry_size = (key > 0 ? 1 + varint_size(key) + key : 0) +
+                        (value > 0 ? 1 + varint_size(value) + value : 0);
+    size += 1 + varint_size(entry_size) + entry_size;
+  }
+  return size;
+}
+
+template <typename T> inline size_t encoded_size(const std::set<T>& set) {
+  size_t size = 0;
+  for (auto& item : set)
+    size += item_size(item);
+  return size;
+}
+
+/** Encodes the first N items of a tuple. */
+template <size_t N, typename... Ts> struct TupleEncoder {
+  static size_t size(const std::tuple<Ts...>& tuple) {
+    return TupleEncoder<N - 1, Ts...>::size(tuple) + item_size(std::get<N - 1>(tuple));
+  }
+  static void write(std::string& buffer, const std::tuple<Ts...>& tuple) {
+    TupleEncoder<N - 1, Ts...>::write(buffer, tuple);
+    write_item(buffer, 1, std::get<N - 1>(tuple));
+  }
+};
+
+template <typename... Ts> struct TupleEncoder<0, Ts...> {
+  static size_t size(const std::tuple<Ts...>&) {
+    return 0;
+  }
+  static void write(std::string&, const std::tuple<Ts...>&) {}
+};
+
+template <typename... Ts> inline size_t encoded_size(const std::tuple<Ts...>& tuple) {
+  return TupleEncoder<sizeof...(Ts), Ts...>::size(tuple);
+}
+
+template <typename T> inline size_t encoded_size(const T& value, std::true_type) {
+  return encoded_size(static_cast<const Object<T>&>(value));
+}
+
+template <typename T> inline size_t encoded_size(const T& value, std::false_type) {
+  return encode(value).size();
+}
+
+template <typename T> inline size_t encoded_size(const T& value) {
+  // Objects are usually passed as their generated class, rather than as Object<T>
+  return encoded_size(value, typename std::is_base_of<Object<T>, T>::type());
+}
+
+inline void encode_to(std::string& buffer, float value) {
+  google::protobuf::uint8 bytes[sizeof(google::protobuf::uint32)];
+  google::protobuf::io::CodedOutputStream::WriteLittleEndian32ToArray(
+    google::protobuf::internal::WireFormatLite::EncodeFloat(value), bytes);
+  buffer.append(reinterpret_cast<const char*>(bytes), sizeof(bytes));
+}
+
+inline void encode_to(std::string& buffer, double value) {
+  google::protobuf::uint8 bytes[sizeof(google::protobuf::uint64)];
+  google::protobuf::io::CodedOutputStream::WriteLittleEndian64ToArray(
+    google::protobuf::internal::WireFormatLite::EncodeDouble(value), bytes);
+  buffer.append(reinterpret_cast<const char*>(bytes), sizeof(bytes));
+}
+
+inline void encode_to(std::string& buffer, google::protobuf::int32 value) {
+  write_varint(buffer, google::protobuf::internal::WireFormatLite::ZigZagEncode32(value));
+}
+
+inline void encode_to(std::string& buffer, google::protobuf::int64 value) {
+  write_varint(buffer, google::protobuf::internal::WireFormatLite::ZigZagEncode64(value));
+}
+
+inline void encode_to(std::string& buffer, google::protobuf::uint32 value) {
+  write_varint(buffer, value);
+}
+
+inline void encode_to(std::string& buffer, google::protobuf::uint64 value) {
+  write_varint(buffer, value);
+}
+
+inline void encode_to(std::string& buffer, bool value) {
+  buffer += static_cast<char>(value ? 1 : 0);
+}
+
+inline void encode_to(std::string& buffer, const char* value) {
+  size_t length = std::char_traits<char>::length(value);
+  write_varint(buffer, length);
+  buffer.append(value, length);
+}
+
+inline void encode_to(std::string& buffer, const std::string& value) {
+  write_varint(buffer, value.size());
+  buffer += value;
+}
+
+template <typename T> inline void encode_to(std::string& buffer, const Object<T>& object) {
+  encode_to(buffer, object._id);
+}
+
+template <typename T> inline void encode_to(std::string& buffer, const std::vector<T>& list) {
+  for (auto& item : list)
+    write_item(buffer, 1, item);
+}
+
+template <typename K, typename V>
+inline void encode_to(std::string& buffer, const std::map<K, V>& dictionary) {
+  const char entry_tag = static_cast<char>(
+    google::protobuf::internal::WireFormatLite::MakeTag(
+      1, google::protobuf::internal::WireFormatLite::WIRETYPE_LENGTH_DELIMITED));
+  for (auto& entry : dictionary) {
+    size_t key = encoded_size(entry.first);
+    size_t value = encoded_size(entry.second);
+    buffer += entry_tag;
+    write_varint(buffer, (key > 0 ? 1 + varint_size(key) + key : 0) +
+                         (value > 0 ? 1 + varint_size(value) + value : 0));
+    if (key > 0)
+      write_item(buffer, 1, entry.first);
+    if (value > 0)
+      write_item(buffer, 2, entry.second);
+  }
+}
+
+template <typename T> inline void encode_to(std::string& buffer, const std::set<T>& set) {
+  for (auto& item : set)
+    write_item(buffer, 1, item);
+}
+
+template <typename... Ts>
+inline void encode_to(std::string& buffer, const std::tuple<Ts...>& tuple) {
+  TupleEncoder<sizeof...(Ts), Ts...>::write(buffer, tuple);
+}
+
+template <typename T>
+inline void encode_to(std::string& buffer, const T& value, std::true_type) {
+  encode_to(buffer, static_cast<const Object<T>&>(value));
+}
+
+template <typename T>
+inline void encode_to(std::string& buffer, const T& value, std::false_type) {
+  buffer += encode(value);
+}
+
+template <typename T> inline void encode_to(std::string& buffer, const T& value) {
+  encode_to(buffer, value, typename std::is_base_of<Object<T>, T>::type());
+}
+
+template <typename T> inline std::string encode_direct(const T& value) {
+  std::string data;
+  data.reserve(encoded_size(value));
+  encode_to(data, value);
+  return data;
+}
+
 template <typename T>
 inline std::string encode(const Object<T>& object) {
   return encode(object._id);
@@ -68,29 +349,17 @@ inline std::string encode(const Object<T>& object) {
 
 template <typename T>
 inline std::string encode(const std::vector<T>& list) {
-  krpc::schema::List listMessage;
-  for (typename std::vector<T>::const_iterator x = list.begin(); x != list.end(); ++x)
-    listMessage.add_items(encode(*x));
-  return encode(listMessage);
+  return encode_direct(list);
 }
 
 template <typename K, typename V>
 inline std::string encode(const std::map<K, V>& dictionary) {
-  krpc::schema::Dictionary dictionaryMessage;
-  for (typename std::map<K, V>::const_iterator x = dictionary.begin(); x != dictionary.end(); ++x) {
-    schema::DictionaryEntry* entry = dictionaryMessage.add_entries();
-    entry->set_key(encode(x->first));
-    entry->set_value(encode(x->second));
-  }
-  return encode(dictionaryMessage);
+  return encode_direct(dictionary);
 }
 
 template <typename T>
 inline std::string encode(const std::set<T>& set) {
-  krpc::schema::Set setMessage;
-  for (typename std::set<T>::const_iterator x = set.begin(); x != set.end(); ++x)
-    setMessage.add_items(encode(*x));
-  return encode(setMessage);
+  return encode_direct(set);
 }
 
 /*[[[cog
@@ -100,58 +369,34 @@ for n in range(1,int(nargs)+1):
     cog.out("""
 template <""" + ', '.join('typename T%d' % i for i in range(n)) + """>
 inline std::string encode(const std::tuple<""" + ', '.join('T%d' % i for i in range(n)) + """>& tuple) {
-  krpc::schema::Tuple tupleMessage;
-""")
-    for i in range(n):
-        cog.outl('  tupleMessage.add_items(encode(std::get<%d>(tuple)));' % i)
-    cog.out("""  return encode(tupleMessage);
+  return encode_direct(tuple);
 }
 """)
 ]]]*/
 
 template <typename T0>
 inline std::string encode(const std::tuple<T0>& tuple) {
-  krpc::schema::Tuple tupleMessage;
-  tupleMessage.add_items(encode(std::get<0>(tuple)));
-  return encode(tupleMessage);
+  return encode_direct(tuple);
 }
 
 template <typename T0, typename T1>
 inline std::string encode(const std::tuple<T0, T1>& tuple) {
-  krpc::schema::Tuple tupleMessage;
-  tupleMessage.add_items(encode(std::get<0>(tuple)));
-  tupleMessage.add_items(encode(std::get<1>(tuple)));
-  return encode(tupleMessage);
+  return encode_direct(tuple);
 }
 
 template <typename T0, typename T1, typename T2>
 inline std::string encode(const std::tuple<T0, T1, T2>& tuple) {
-  krpc::schema::Tuple tupleMessage;
-  tupleMessage.add_items(encode(std::get<0>(tuple)));
-  tupleMessage.add_items(encode(std::get<1>(tuple)));
-  tupleMessage.add_items(encode(std::get<2>(tuple)));
-  return encode(tupleMessage);
+  return encode_direct(tuple);
 }
 
 template <typename T0, typename T1, typename T2, typename T3>
 inline std::string encode(const std::tuple<T0, T1, T2, T3>& tuple) {
-  krpc::schema::Tuple tupleMessage;
-  tupleMessage.add_items(encode(std::get<0>(tuple)));
-  tupleMessage.add_items(encode(std::get<1>(tuple)));
-  tupleMessage.add_items(encode(std::get<2>(tuple)));
-  tupleMessage.add_items(encode(std::get<3>(tuple)));
-  return encode(tupleMessage);
+  return encode_direct(tuple);
 }
 
 template <typename T0, typename T1, typename T2, typename T3, typename T4>
 inline std::string encode(const std::tuple<T0, T1, T2, T3, T4>& tuple) {
-  krpc::schema::Tuple tupleMessage;
-  tupleMessage.add_items(encode(std::get<0>(tuple)));
-  tupleMessage.add_items(encode(std::get<1>(tuple)));
-  tupleMessage.add_items(encode(std::get<2>(tuple)));
-  tupleMessage.add_items(encode(std::get<3>(tuple)));
-  tupleMessage.add_items(encode(std::get<4>(tuple)));
-  return encode(tupleMessage);
+  return encode_direct(tuple);
 }
 // [[[end]]]
 
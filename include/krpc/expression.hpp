@@ -0,0 +1,574 @@
+#pragma once
+
+#include <google/protobuf/stubs/port.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>  // NOLINT(build/c++11)
+#include <limits>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "krpc/batch.hpp"
+#include "krpc/client.hpp"
+#include "krpc/event.hpp"
+#include "krpc/krpc.pb.hpp"
+#include "krpc/services/krpc.hpp"
+
+namespace krpc {
+
+/**
+ * Builds KRPC::Expression trees on the client. The free functions and operators over Expr
+ * are in this namespace, rather than in krpc, so that they do not collide with, or
+ * implicitly convert the arguments of, other functions in krpc. They are found by
+ * argument dependent lookup when called with an Expr.
+ */
+namespace expr {
+
+/** The type of the value of an expression, if it is known. */
+enum struct ExprType {
+  unknown,
+  bool_,
+  int32,
+  float_,
+  double_,
+  string
+};
+
+/** The ExprType of a C++ type. */
+template <typename T> struct ExprTypeOf;
+template <> struct ExprTypeOf<bool> { static const ExprType value = ExprType::bool_; };
+template <> struct ExprTypeOf<int32_t> { static const ExprType value = ExprType::int32; };
+template <> struct ExprTypeOf<float> { static const ExprType value = ExprType::float_; };
+template <> struct ExprTypeOf<double> { static const ExprType value = ExprType::double_; };
+template <> struct ExprTypeOf<std::string> { static const ExprType value = ExprType::string; };
+
+/**
+ * An expression that is built on the client and evaluated by the server, for example
+ * as the condition of an event:
+ *
+ *   using krpc::expr::Expr;
+ *   Expr condition = krpc::expr::expr<double>(flight.mean_altitude_call()) > 70000 &&
+ *                    krpc::expr::expr<double>(flight.speed_call()) < 2200;
+ *   krpc::Event event = add_event(&client, condition);
+ *
+ * Creating each node of a KRPC::Expression is a separate call. Building the tree with
+ * Expr costs no calls until build() is called, which creates all the nodes at the same
+ * depth in one batch, and nodes that appear more than once in the tree only once.
+ *
+ * The server requires the operands of an operator to have the same type. Numeric
+ * literals take the type of the other operand, if it is known, so the type of calls
+ * should be given where possible, using expr<T>().
+ */
+class Expr {
+ public:
+  typedef services::KRPC::Expression Expression;
+  typedef std::vector<google::protobuf::uint64> Ids;
+  /** Builds the call that creates a node, given the ids of its operands on the server. */
+  typedef std::function<schema::ProcedureCall(Client&, const Ids&)> Builder;
+  typedef schema::ProcedureCall (*UnaryCall)(Client&, Expression);
+  typedef schema::ProcedureCall (*BinaryCall)(Client&, Expression, Expression);
+
+  Expr(bool value);  // NOLINT(runtime/explicit)
+  Expr(int32_t value);  // NOLINT(runtime/explicit)
+  Expr(float value);  // NOLINT(runtime/explicit)
+  Expr(double value);  // NOLINT(runtime/explicit)
+  Expr(const char * value);  // NOLINT(runtime/explicit)
+  Expr(const std::string& value);  // NOLINT(runtime/explicit)
+  /** An expression that already exists on the server. */
+  Expr(const Expression& expression, ExprType type = ExprType::unknown);  // NOLINT
+  /** A node created by builder, whose operands are created first. */
+  Expr(const Builder& builder, const std::vector<Expr>& operands,
+       ExprType type = ExprType::unknown);
+
+  static Expr unary(UnaryCall call, const Expr& arg, ExprType type);
+  /** A binary operator. A numeric literal operand takes the type of the other operand. */
+  static Expr binary(BinaryCall call, const Expr& arg0, const Expr& arg1, ExprType type);
+  /** An expression for a type, used as the operand of casts and parameters. */
+  static Expr type_of(ExprType type);
+
+  ExprType type() const;
+  /** Create the expression on the server. */
+  Expression build(Client * client) const;
+
+ private:
+  struct Node {
+    Builder builder;
+    std::vector<std::shared_ptr<const Node>> operands;
+    ExprType type;
+    /** The id of a node that already exists on the server, or zero */
+    google::protobuf::uint64 id;
+    /** Whether the node is a numeric literal, whose value is number */
+    bool literal;
+    double number;
+  };
+  /** Throws std::invalid_argument if number can't be represented exactly as type. */
+  static Expr constant(double number, ExprType type);
+  /**
+   * Whether number converts to type without overflowing. An int32 must also be finite, and
+   * have no fractional part.
+   */
+  static bool representable(double number, ExprType type);
+  /** The type that a binary operator's operands are converted to, or unknown. */
+  static ExprType common_type(const Expr& arg0, const Expr& arg1);
+  static Expr coerce(const Expr& arg, ExprType type);
+  static size_t depth(const std::shared_ptr<const Node>& node,
+                      std::map<const Node*, size_t>& depths,
+                      std::vector<std::vector<const Node*>>& levels);
+  std::shared_ptr<Node> node;
+};
+
+/** A procedure call, evaluated by the server each time the expression is. */
+Expr expr(const schema::ProcedureCall& call);
+/** A procedure call that returns a value of type T. */
+template <typename T> Expr expr(const schema::ProcedureCall& call);
+/** Convert the value of an expression to type T. */
+template <typename T> Expr cast(const Expr& arg);
+/** A parameter of type T, for use in the body of a function. */
+template <typename T> Expr parameter(const std::string& name);
+/** A function, for use with select(), where(), all_of(), any_of() and order_by(). */
+Expr lambda(const std::vector<Expr>& parameters, const Expr& body);
+Expr pow(const Expr& arg0, const Expr& arg1);
+
+Expr operator+(const Expr& arg0, const Expr& arg1);
+Expr operator-(const Expr& arg0, const Expr& arg1);
+Expr operator*(const Expr& arg0, const Expr& arg1);
+Expr operator/(const Expr& arg0, const Expr& arg1);
+Expr operator%(const Expr& arg0, const Expr& arg1);
+Expr operator<<(const Expr& arg0, const Expr& arg1);
+Expr operator>>(const Expr& arg0, const Expr& arg1);
+Expr operator==(const Expr& arg0, const Expr& arg1);
+Expr operator!=(const Expr& arg0, const Expr& arg1);
+Expr operator<(const Expr& arg0, const Expr& arg1);
+Expr operator<=(const Expr& arg0, const Expr& arg1);
+Expr operator>(const Expr& arg0, const Expr& arg1);
+Expr operator>=(const Expr& arg0, const Expr& arg1);
+/** Logical and. Unlike the built in operator, both operands are always evaluated. */
+Expr operator&&(const Expr& arg0, const Expr& arg1);
+/** Logical or. Unlike the built in operator, both operands are always evaluated. */
+Expr operator||(const Expr& arg0, const Expr& arg1);
+Expr operator^(const Expr& arg0, const Expr& arg1);
+Expr operator!(const Expr& arg);
+
+// Collections
+Expr create_list(const std::vector<Expr>& values);
+Expr create_tuple(const std::vector<Expr>& elements);
+Expr get(const Expr& collection, const Expr& index);
+Expr contains(const Expr& collection, const Expr& value);
+Expr concat(const Expr& collection1, const Expr& collection2);
+Expr select(const Expr& collection, const Expr& function);
+Expr where(const Expr& collection, const Expr& function);
+Expr all_of(const Expr& collection, const Expr& predicate);
+Expr any_of(const Expr& collection, const Expr& predicate);
+Expr order_by(const Expr& collection, const Expr& key);
+Expr count(const Expr& collection);
+Expr sum(const Expr& collection);
+Expr max(const Expr& collection);
+Expr min(const Expr& collection);
+Expr average(const Expr& collection);
+Expr to_list(const Expr& collection);
+Expr to_set(const Expr& collection);
+
+}  // namespace expr
+
+/** Create an event that is triggered when condition becomes true. */
+Event add_event(Client * client, const expr::Expr& condition);
+
+namespace expr {
+
+inline Expr::Expr(bool value) : node(std::make_shared<Node>()) {
+  node->builder = [value] (Client& client, const Ids&) {
+    return Expression::constant_bool_call(client, value);
+  };
+  node->type = ExprType::bool_;
+  node->id = 0;
+  node->literal = false;
+}
+
+inline Expr::Expr(int32_t value) : Expr(constant(value, ExprType::int32)) {}
+
+inline Expr::Expr(float value) : Expr(constant(value, ExprType::float_)) {}
+
+inline Expr::Expr(double value) : Expr(constant(value, ExprType::double_)) {}
+
+inline Expr::Expr(const char * value) : Expr(std::string(value)) {}
+
+inline Expr::Expr(const std::string& value) : node(std::make_shared<Node>()) {
+  node->builder = [value] (Client& client, const Ids&) {
+    return Expression::constant_string_call(client, value);
+  };
+  node->type = ExprType::string;
+  node->id = 0;
+  node->literal = false;
+}
+
+inline Expr::Expr(const Expression& expression, ExprType type) : node(std::make_shared<Node>()) {
+  node->type = type;
+  node->id = expression._id;
+  node->literal = false;
+}
+
+inline Expr::Expr(const Builder& builder, const std::vector<Expr>& operands, ExprType type) :
+  node(std::make_shared<Node>()) {
+  node->builder = builder;
+  for (auto& operand : operands)
+    node->operands.push_back(operand.node);
+  node->type = type;
+  node->id = 0;
+  node->literal = false;
+}
+
+inline Expr Expr::unary(UnaryCall call, const Expr& arg, ExprType type) {
+  return Expr([call] (Client& client, const Ids& ids) {
+    return call(client, Expression(&client, ids[0]));
+  }, {arg}, type);
+}
+
+inline Expr Expr::binary(BinaryCall call, const Expr& arg0, const Expr& arg1, ExprType type) {
+  ExprType common = common_type(arg0, arg1);
+  return Expr([call] (Client& client, const Ids& ids) {
+    return call(client, Expression(&client, ids[0]), Expression(&client, ids[1]));
+  }, {coerce(arg0, common), coerce(arg1, common)}, type);
+}
+
+inline Expr Expr::type_of(ExprType type) {
+  typedef services::KRPC::Type Type;
+  schema::ProcedureCall (*call)(Client&) = nullptr;
+  switch (type) {
+  case ExprType::bool_:
+    call = &Type::bool__call;
+    break;
+  case ExprType::int32:
+    call = &Type::int__call;
+    break;
+  case ExprType::float_:
+    call = &Type::float__call;
+    break;
+  case ExprType::double_:
+    call = &Type::double__call;
+    break;
+  case ExprType::string:
+    call = &Type::string_call;
+    break;
+  default:
+    throw std::invalid_argument("Expression type is unknown");
+  }
+  return Expr([call] (Client& client, const Ids&) { return call(client); }, {});
+}
+
+inline ExprType Expr::type() const {
+  return node->type;
+}
+
+inline Expr::Expression Expr::build(Client * client) const {
+  if (node->id != 0)
+    return Expression(client, node->id);
+  // Every node at a given depth only depends on nodes at lower depths,
+  // so they can be created together
+  std::map<const Node*, size_t> depths;
+  std::vector<std::vector<const Node*>> levels;
+  depth(node, depths, levels);
+  std::map<const Node*, google::protobuf::uint64> ids;
+  for (auto& level : levels) {
+    Batch batch = client->batch();
+    std::vector<std::future<google::protobuf::uint64>> results;
+    for (auto current : level) {
+      Ids operands;
+      for (auto& operand : current->operands)
+        operands.push_back(operand->id != 0 ? operand->id : ids[operand.get()]);
+      results.push_back(
+        batch.add<google::protobuf::uint64>(current->builder(*client, operands)));
+    }
+    batch.send();
+    for (size_t i = 0; i < level.size(); i++)
+      ids[level[i]] = results[i].get();
+  }
+  return Expression(client, ids[node.get()]);
+}
+
+inline Expr Expr::constant(double number, ExprType type) {
+  if ((type == ExprType::int32 || type == ExprType::float_) && !representable(number, type))
+    throw std::invalid_argument("Literal " + std::to_string(number) + " is out of range");
+  Expr result(false);
+  Node& node = *result.node;
+  switch (type) {
+  case ExprType::int32:
+    node.builder = [number] (Client& client, const Ids&) {
+      return Expression::constant_int_call(client, static_cast<int32_t>(number));
+    };
+    break;
+  case ExprType::float_:
+    node.builder = [number] (Client& client, const Ids&) {
+      return Expression::constant_float_call(client, static_cast<float>(number));
+    };
+    break;
+  default:
+    node.builder = [number] (Client& client, const Ids&) {
+      return Expression::constant_double_call(client, number);
+    };
+    break;
+  }
+  node.type = type;
+  node.literal = true;
+  node.number = number;
+  return result;
+}
+
+inline ExprType Expr::common_type(const Expr& arg0, const Expr& arg1) {
+  const Node& node0 = *arg0.node;
+  const Node& node1 = *arg1.node;
+  if (node0.literal == node1.literal || node0.type == node1.type)
+    return ExprType::unknown;
+  const Node& other = node0.literal ? node1 : node0;
+  const Node& literal = node0.literal ? node0 : node1;
+  // Literals are only widened to floating point, or narrowed from double to float
+  if (other.type == ExprType::double_)
+    return other.type;
+  if ((other.type == ExprType::float_ || other.type == ExprType::int32) &&
+      representable(literal.number, other.type))
+    return other.type;
+  return ExprType::unknown;
+}
+
+inline bool Expr::representable(double number, ExprType type) {
+  if (type == ExprType::int32)
+    return std::isfinite(number) &&
+           number >= std::numeric_limits<int32_t>::min() &&
+           number <= std::numeric_limits<int32_t>::max() &&
+           number == std::trunc(number);
+  if (type == ExprType::float_)
+    return !std::isfinite(number) || std::fabs(number) <= std::numeric_limits<float>::max();
+  return true;
+}
+
+inline Expr Expr::coerce(const Expr& arg, ExprType type) {
+  if (type == ExprType::unknown || !arg.node->literal || arg.node->type == type)
+    return arg;
+  return constant(arg.node->number, type);
+}
+
+inline size_t Expr::depth(const std::shared_ptr<const Node>& node,
+                          std::map<const Node*, size_t>& depths,
+                          std::vector<std::vector<const Node*>>& levels) {
+  if (node->id != 0)
+    return 0;
+  auto it = depths.find(node.get());
+  if (it != depths.end())
+    return it->second;
+  size_t result = 1;
+  for (auto& operand : node->operands)
+    result = std::max(result, depth(operand, depths, levels) + 1);
+  depths[node.get()] = result;
+  if (levels.size() < result)
+    levels.resize(result);
+  levels[result - 1].push_back(node.get());
+  return result;
+}
+
+inline Expr expr(const schema::ProcedureCall& call) {
+  return Expr([call] (Client& client, const Expr::Ids&) {
+    return Expr::Expression::call_call(client, call);
+  }, {});
+}
+
+template <typename T> inline Expr expr(const schema::ProcedureCall& call) {
+  return Expr([call] (Client& client, const Expr::Ids&) {
+    return Expr::Expression::call_call(client, call);
+  }, {}, ExprTypeOf<T>::value);
+}
+
+template <typename T> inline Expr cast(const Expr& arg) {
+  return Expr([] (Client& client, const Expr::Ids& ids) {
+    return Expr::Expression::cast_call(
+      client, Expr::Expression(&client, ids[0]), services::KRPC::Type(&client, ids[1]));
+  }, {arg, Expr::type_of(ExprTypeOf<T>::value)}, ExprTypeOf<T>::value);
+}
+
+template <typename T> inline Expr parameter(const std::string& name) {
+  return Expr([name] (Client& client, const Expr::Ids& ids) {
+    return Expr::Expression::parameter_call(client, name, services::KRPC::Type(&client, ids[0]));
+  }, {Expr::type_of(ExprTypeOf<T>::value)}, ExprTypeOf<T>::value);
+}
+
+inline Expr lambda(const std::vector<Expr>& parameters, const Expr& body) {
+  std::vector<Expr> operands(parameters);
+  operands.push_back(body);
+  return Expr([] (Client& client, const Expr::Ids& ids) {
+    std::vector<Expr::Expression> parameters;
+    for (size_t i = 0; i + 1 < ids.size(); i++)
+      parameters.push_back(Expr::Expression(&client, ids[i]));
+    return Expr::Expression::function_call(
+      client, parameters, Expr::Expression(&client, ids.back()));
+  }, operands);
+}
+
+inline Expr pow(const Expr& arg0, const Expr& arg1) {
+  return Expr::binary(&Expr::Expression::power_call, arg0, arg1, arg0.type());
+}
+
+inline Expr operator+(const Expr& arg0, const Expr& arg1) {
+  return Expr::binary(&Expr::Expression::add_call, arg0, arg1,
+                      arg0.type() != ExprType::unknown ? arg0.type() : arg1.type());
+}
+
+inline Expr operator-(const Expr& arg0, const Expr& arg1) {
+  return Expr::binary(&Expr::Expression::subtract_call, arg0, arg1,
+                      arg0.type() != ExprType::unknown ? arg0.type() : arg1.type());
+}
+
+inline Expr operator*(const Expr& arg0, const Expr& arg1) {
+  return Expr::binary(&Expr::Expression::multiply_call, arg0, arg1,
+                      arg0.type() != ExprType::unknown ? arg0.type() : arg1.type());
+}
+
+inline Expr operator/(const Expr& arg0, const Expr& arg1) {
+  return Expr::binary(&Expr::Expression::divide_call, arg0, arg1,
+                      arg0.type() != ExprType::unknown ? arg0.type() : arg1.type());
+}
+
+inline Expr operator%(const Expr& arg0, const Expr& arg1) {
+  return Expr::binary(&Expr::Expression::modulo_call, arg0, arg1,
+                      arg0.type() != ExprType::unknown ? arg0.type() : arg1.type());
+}
+
+inline Expr operator<<(const Expr& arg0, const Expr& arg1) {
+  return Expr::binary(&Expr::Expression::left_shift_call, arg0, arg1, arg0.type());
+}
+
+inline Expr operator>>(const Expr& arg0, const Expr& arg1) {
+  return Expr::binary(&Expr::Expression::right_shift_call, arg0, arg1, arg0.type());
+}
+
+inline Expr operator==(const Expr& arg0, const Expr& arg1) {
+  return Expr::binary(&Expr::Expression::equal_call, arg0, arg1, ExprType::bool_);
+}
+
+inline Expr operator!=(const Expr& arg0, const Expr& arg1) {
+  return Expr::binary(&Expr::Expression::not_equal_call, arg0, arg1, ExprType::bool_);
+}
+
+inline Expr operator<(const Expr& arg0, const Expr& arg1) {
+  return Expr::binary(&Expr::Expression::less_than_call, arg0, arg1, ExprType::bool_);
+}
+
+inline Expr operator<=(const Expr& arg0, const Expr& arg1) {
+  return Expr::binary(&Expr::Expression::less_than_or_equal_call, arg0, arg1, ExprType::bool_);
+}
+
+inline Expr operator>(const Expr& arg0, const Expr& arg1) {
+  return Expr::binary(&Expr::Expression::greater_than_call, arg0, arg1, ExprType::bool_);
+}
+
+inline Expr operator>=(const Expr& arg0, const Expr& arg1) {
+  return Expr::binary(&Expr::Expression::greater_than_or_equal_call, arg0, arg1,
+                      ExprType::bool_);
+}
+
+inline Expr operator&&(const Expr& arg0, const Expr& arg1) {
+  return Expr::binary(&Expr::Expression::and__call, arg0, arg1, ExprType::bool_);
+}
+
+inline Expr operator||(const Expr& arg0, const Expr& arg1) {
+  return Expr::binary(&Expr::Expression::or__call, arg0, arg1, ExprType::bool_);
+}
+
+inline Expr operator^(const Expr& arg0, const Expr& arg1) {
+  return Expr::binary(&Expr::Expression::exclusive_or_call, arg0, arg1, arg0.type());
+}
+
+inline Expr operator!(const Expr& arg) {
+  return Expr::unary(&Expr::Expression::not__call, arg, ExprType::bool_);
+}
+
+inline Expr create_list(const std::vector<Expr>& values) {
+  return Expr([] (Client& client, const Expr::Ids& ids) {
+    std::vector<Expr::Expression> values;
+    for (auto id : ids)
+      values.push_back(Expr::Expression(&client, id));
+    return Expr::Expression::create_list_call(client, values);
+  }, values);
+}
+
+inline Expr create_tuple(const std::vector<Expr>& elements) {
+  return Expr([] (Client& client, const Expr::Ids& ids) {
+    std::vector<Expr::Expression> elements;
+    for (auto id : ids)
+      elements.push_back(Expr::Expression(&client, id));
+    return Expr::Expression::create_tuple_call(client, elements);
+  }, elements);
+}
+
+inline Expr get(const Expr& collection, const Expr& index) {
+  return Expr::binary(&Expr::Expression::get_call, collection, index, ExprType::unknown);
+}
+
+inline Expr contains(const Expr& collection, const Expr& value) {
+  return Expr::binary(&Expr::Expression::contains_call, collection, value, ExprType::bool_);
+}
+
+inline Expr concat(const Expr& collection1, const Expr& collection2) {
+  return Expr::binary(&Expr::Expression::concat_call, collection1, collection2,
+                      ExprType::unknown);
+}
+
+inline Expr select(const Expr& collection, const Expr& function) {
+  return Expr::binary(&Expr::Expression::select_call, collection, function, ExprType::unknown);
+}
+
+inline Expr where(const Expr& collection, const Expr& function) {
+  return Expr::binary(&Expr::Expression::where_call, collection, function, ExprType::unknown);
+}
+
+inline Expr all_of(const Expr& collection, const Expr& predicate) {
+  return Expr::binary(&Expr::Expression::all_call, collection, predicate, ExprType::bool_);
+}
+
+inline Expr any_of(const Expr& collection, const Expr& predicate) {
+  return Expr::binary(&Expr::Expression::any_call, collection, predicate, ExprType::bool_);
+}
+
+inline Expr order_by(const Expr& collection, const Expr& key) {
+  return Expr::binary(&Expr::Expression::order_by_call, collection, key, ExprType::unknown);
+}
+
+inline Expr count(const Expr& collection) {
+  return Expr::unary(&Expr::Expression::count_call, collection, ExprType::int32);
+}
+
+inline Expr sum(const Expr& collection) {
+  return Expr::unary(&Expr::Expression::sum_call, collection, ExprType::unknown);
+}
+
+inline Expr max(const Expr& collection) {
+  return Expr::unary(&Expr::Expression::max_call, collection, ExprType::unknown);
+}
+
+inline Expr min(const Expr& collection) {
+  return Expr::unary(&Expr::Expression::min_call, collection, ExprType::unknown);
+}
+
+inline Expr average(const Expr& collection) {
+  return Expr::unary(&Expr::Expression::average_call, collection, ExprType::double_);
+}
+
+inline Expr to_list(const Expr& collection) {
+  return Expr::unary(&Expr::Expression::to_list_call, collection, ExprType::unknown);
+}
+
+inline Expr to_set(const Expr& collection) {
+  return Expr::unary(&Expr::Expression::to_set_call, collection, ExprType::unknown);
+}
+
+}  // namespace expr
+
+inline Event add_event(Client * client, const expr::Expr& condition) {
+  return services::KRPC(client).add_event(condition.build(client));
+}
+
+}  // namespace krpc
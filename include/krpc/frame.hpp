@@ -0,0 +1,135 @@
+#pragma once
+
+#include <google/protobuf/stubs/port.h>
+
+#include <cstddef>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+
+#include "krpc/client.hpp"
+#include "krpc/error.hpp"
+#include "krpc/stream.hpp"
+#include "krpc/stream_cache.hpp"
+
+namespace krpc {
+
+/**
+ * A group of streams whose values are published together. The server sends the values of
+ * all streams for one physics tick in a single stream update message. Once the client has
+ * processed a message, the frame copies the values of its streams and publishes them as
+ * one tuple, so readers never see values from different messages. Frames are numbered
+ * from 1, and a new frame is published for each message that updates any of the streams.
+ * Reading a frame does not take a lock.
+ */
+template <typename... Ts>
+class Frame {
+  static_assert(sizeof...(Ts) > 0, "A frame must contain at least one stream");
+
+ public:
+  typedef std::tuple<Ts...> Values;
+  /**
+   * Create a frame from streams of the given client. Starts the streams. The first frame is
+   * published once the client has processed the next stream update message.
+   */
+  explicit Frame(Client * client, const Stream<Ts>&... streams);
+  Frame(Frame&& other);
+  ~Frame();
+  /** The values in the most recent frame. */
+  Values get() const;
+  /** The values in the most recent frame, and its number. */
+  Values get(google::protobuf::uint64& frame) const;
+  /** The number of the most recent frame, or zero if none has been published. */
+  google::protobuf::uint64 frame() const;
+
+ private:
+  static const size_t size = sizeof...(Ts);
+  struct State {
+    std::tuple<std::shared_ptr<StreamCache<Ts>>...> caches;
+    /** Sequence numbers of the streams in the most recent frame */
+    google::protobuf::uint64 sequences[sizeof...(Ts)];
+    typename PublishedValue<Values>::type values;
+    void publish();
+  };
+  template <size_t I, typename Enable = void>
+  struct Loader {
+    /** Copy the values of the streams from index I onwards. Returns false if any are missing. */
+    static bool load(State& state, Values& values, google::protobuf::uint64 * sequences) {
+      if (!std::get<I>(state.caches)->load(std::get<I>(values), sequences[I]))
+        return false;
+      return Loader<I + 1>::load(state, values, sequences);
+    }
+  };
+  template <size_t I>
+  struct Loader<I, typename std::enable_if<I == sizeof...(Ts)>::type> {
+    static bool load(State&, Values&, google::protobuf::uint64 *) { return true; }
+  };
+  Frame(const Frame&) = delete;
+  Frame& operator=(const Frame&) = delete;
+  Client * client;
+  std::tuple<Stream<Ts>...> streams;
+  std::shared_ptr<State> state;
+  int tag;
+};
+
+template <typename... Ts> inline Frame<Ts...>::Frame(Client * client,
+                                                     const Stream<Ts>&... streams) :
+  client(client), streams(streams...), state(std::make_shared<State>()) {
+  state->caches = std::make_tuple(Stream<Ts>(streams).cache()...);
+  for (size_t i = 0; i < size; i++)
+    state->sequences[i] = 0;
+  // Start the streams, so that the first frame is published as soon as possible
+  int started[] = {0, (Stream<Ts>(streams).start(false), 0)...};
+  (void)started;
+  std::shared_ptr<State> state = this->state;
+  // Only publish from the stream update callback, which runs once the update thread has
+  // applied a whole message, so that a frame never mixes values from two messages
+  tag = client->add_stream_update_callback([state] { state->publish(); });
+}
+
+template <typename... Ts> inline Frame<Ts...>::Frame(Frame&& other) :
+  client(other.client), streams(std::move(other.streams)), state(std::move(other.state)),
+  tag(other.tag) {
+  other.tag = -1;
+}
+
+template <typename... Ts> inline Frame<Ts...>::~Frame() {
+  if (tag >= 0)
+    client->remove_stream_update_callback(tag);
+}
+
+template <typename... Ts> inline typename Frame<Ts...>::Values Frame<Ts...>::get() const {
+  google::protobuf::uint64 frame;
+  return get(frame);
+}
+
+template <typename... Ts> inline typename Frame<Ts...>::Values Frame<Ts...>::get(
+  google::protobuf::uint64& frame) const {
+  Values values;
+  if (!state->values.load(values, frame))
+    throw StreamError("No frame has been received");
+  return values;
+}
+
+template <typename... Ts> inline google::protobuf::uint64 Frame<Ts...>::frame() const {
+  return state->values.version();
+}
+
+template <typename... Ts> inline void Frame<Ts...>::State::publish() {
+  // Called on the stream update thread once a message has been processed, so it is the
+  // only writer
+  Values next;
+  google::protobuf::uint64 next_sequences[sizeof...(Ts)];
+  if (!Loader<0>::load(*this, next, next_sequences))
+    return;
+  bool changed = false;
+  for (size_t i = 0; i < size; i++)
+    changed = changed || next_sequences[i] != sequences[i];
+  if (!changed)
+    return;
+  for (size_t i = 0; i < size; i++)
+    sequences[i] = next_sequences[i];
+  values.store(next);
+}
+
+}  // namespace krpc
@@ -0,0 +1,206 @@
+#pragma once
+
+#include <chrono>  // NOLINT(build/c++11)
+#include <condition_variable>  // NOLINT(build/c++11)
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>  // NOLINT(build/c++11)
+#include <string>
+#include <type_traits>
+
+#include "krpc/client.hpp"
+#include "krpc/decoder.hpp"
+#include "krpc/error.hpp"
+#include "krpc/krpc.pb.hpp"
+#include "krpc/pipeline.hpp"
+
+namespace krpc {
+
+/** Shared state of a Future. Holds the encoded result of the call. */
+class FutureImpl {
+ public:
+  FutureImpl();
+  void set(const std::string& data, const std::exception_ptr& exception);
+  bool is_ready() const;
+  void wait();
+  bool wait_for(double timeout);
+  /** Returns the encoded result. Throws if the call failed. */
+  const std::string& get_data();
+  typedef std::function<void()> Callback;
+  /** Set a callback that is invoked once the result is ready. If the result is already
+      ready, the callback is invoked immediately. */
+  void set_callback(const Callback& callback);
+
+ private:
+  mutable std::mutex lock;
+  std::condition_variable condition;
+  bool ready;
+  std::string data;
+  std::exception_ptr exception;
+  Callback callback;
+};
+
+/**
+ * The result of a procedure call made asynchronously using Client::invoke_async.
+ * The value is decoded when it is retrieved using get().
+ */
+template <typename T>
+class Future {
+ public:
+  /**
+   * Decodes the result. The generated services pass a function that calls decoder::decode
+   * from non-template code, so that decoders declared after this header, such as those for
+   * the services' enumerations, are found.
+   */
+  typedef void (*Decoder)(typename std::conditional<std::is_void<T>::value, char, T>::type&,
+                          const std::string&, Client*);
+  Future();
+  /** Invoke a call, decoding its result using decoder::decode. */
+  Future(Client* client, const schema::ProcedureCall& call);
+  Future(Client* client, const schema::ProcedureCall& call, Decoder decoder);
+  /** Wait for the result of the call and return it. Throws if the call failed. */
+  T get();
+  /** Whether the result of the call has been received. */
+  bool is_ready() const;
+  /** Wait until the result is received. */
+  void wait() const;
+  /** Wait until the result is received, for up to timeout seconds.
+      Returns true if the result was received. */
+  bool wait_for(double timeout) const;
+  typedef std::function<void()> Callback;
+  /**
+   * Set a callback that is invoked once the result has been received. It is invoked on
+   * the thread that receives responses, so must not block. If the result has already
+   * been received, the callback is invoked immediately.
+   */
+  void set_callback(const Callback& callback);
+  explicit operator bool() const;
+
+ private:
+  template <typename U> static void decode(U& value, const std::string& data, Client* client);
+  Client* client;
+  std::shared_ptr<FutureImpl> impl;
+  Decoder decoder;
+  void check_exists() const;
+};
+
+inline FutureImpl::FutureImpl() : ready(false) {
+}
+
+inline void FutureImpl::set(const std::string& data, const std::exception_ptr& exception) {
+  Callback callback;
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    this->data = data;
+    this->exception = exception;
+    ready = true;
+    callback.swap(this->callback);
+  }
+  condition.notify_all();
+  if (callback)
+    callback();
+}
+
+inline bool FutureImpl::is_ready() const {
+  std::lock_guard<std::mutex> guard(lock);
+  return ready;
+}
+
+inline void FutureImpl::wait() {
+  std::unique_lock<std::mutex> guard(lock);
+  condition.wait(guard, [this] { return ready; });
+}
+
+inline bool FutureImpl::wait_for(double timeout) {
+  std::unique_lock<std::mutex> guard(lock);
+  auto rel_time = std::chrono::milliseconds(static_cast<int>(timeout*1000));
+  return condition.wait_for(guard, rel_time, [this] { return ready; });
+}
+
+inline const std::string& FutureImpl::get_data() {
+  wait();
+  if (exception)
+    std::rethrow_exception(exception);
+  return data;
+}
+
+inline void FutureImpl::set_callback(const Callback& callback) {
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    if (!ready) {
+      this->callback = callback;
+      return;
+    }
+  }
+  callback();
+}
+
+template <typename T> inline Future<T>::Future() :
+  client(nullptr), impl(nullptr), decoder(nullptr) {
+}
+
+template <typename T> inline Future<T>::Future(Client* client, const schema::ProcedureCall& call) :
+  Future(client, call, &Future<T>::template decode<T>) {
+}
+
+template <> inline Future<void>::Future(Client* client, const schema::ProcedureCall& call) :
+  Future(client, call, nullptr) {
+}
+
+template <typename T> inline Future<T>::Future(Client* client, const schema::ProcedureCall& call,
+                                               Decoder decoder) :
+  client(client), impl(std::make_shared<FutureImpl>()), decoder(decoder) {
+  std::shared_ptr<FutureImpl> impl = this->impl;
+  client->invoke_async(call, [impl] (const std::string& data, const std::exception_ptr& exception) {
+    impl->set(data, exception);
+  });
+}
+
+template <typename T> inline T Future<T>::get() {
+  check_exists();
+  T value;
+  decoder(value, impl->get_data(), client);
+  return value;
+}
+
+template <> inline void Future<void>::get() {
+  check_exists();
+  impl->get_data();
+}
+
+template <typename T> inline bool Future<T>::is_ready() const {
+  check_exists();
+  return impl->is_ready();
+}
+
+template <typename T> inline void Future<T>::wait() const {
+  check_exists();
+  impl->wait();
+}
+
+template <typename T> inline bool Future<T>::wait_for(double timeout) const {
+  check_exists();
+  return impl->wait_for(timeout);
+}
+
+template <typename T> inline void Future<T>::set_callback(const Callback& callback) {
+  check_exists();
+  impl->set_callback(callback);
+}
+
+template <typename T> inline Future<T>::operator bool() const {
+  return impl.operator bool();
+}
+
+template <typename T> template <typename U>
+inline void Future<T>::decode(U& value, const std::string& data, Client* client) {
+  ::krpc::decoder::decode(value, data, client);
+}
+
+template <typename T> inline void Future<T>::check_exists() const {
+  if (!impl)
+    throw RPCError("Future does not refer to a procedure call");
+}
+
+}  // namespace krpc
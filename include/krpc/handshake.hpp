@@ -0,0 +1,36 @@
+#pragma once
+
+#include <string>
+
+#include "krpc/krpc.pb.hpp"
+
+namespace krpc {
+
+/**
+ * Answer a connection request, for the servers used to test clients, MockServer and
+ * LocalServer. A valid request for a connection of the given type is accepted. RPC
+ * connections are all given the same client identifier, so that a recorded session
+ * replays the same way for any client.
+ */
+schema::ConnectionResponse answer_connection_request(const std::string& message,
+                                                     schema::ConnectionRequest::Type type);
+
+inline schema::ConnectionResponse answer_connection_request(
+  const std::string& message, schema::ConnectionRequest::Type type) {
+  schema::ConnectionRequest request;
+  schema::ConnectionResponse response;
+  if (!request.ParseFromString(message)) {
+    response.set_status(schema::ConnectionResponse::MALFORMED_MESSAGE);
+    response.set_message("Malformed connection request");
+  } else if (request.type() != type) {
+    response.set_status(schema::ConnectionResponse::WRONG_TYPE);
+    response.set_message("Wrong connection type");
+  } else {
+    response.set_status(schema::ConnectionResponse::OK);
+    if (type == schema::ConnectionRequest::RPC)
+      response.set_client_identifier(std::string(16, '\x01'));
+  }
+  return response;
+}
+
+}  // namespace krpc
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <mutex>  // NOLINT(build/c++11)
+#include <string>
+
+#include "krpc/client.hpp"
+#include "krpc/connection.hpp"
+#include "krpc/error.hpp"
+#include "krpc/krpc.pb.hpp"
+#include "krpc/message_parser.hpp"
+
+namespace krpc {
+
+/**
+ * Buffers for Client::invoke() that are reused from one call to the next. Once they have
+ * grown to fit the largest request and response, calling procedures does not allocate
+ * memory. Not thread safe: use one per thread.
+ */
+class InvokeBuffers {
+ public:
+  InvokeBuffers() {}
+
+ private:
+  InvokeBuffers(const InvokeBuffers&) = delete;
+  InvokeBuffers& operator=(const InvokeBuffers&) = delete;
+  friend class Client;
+  schema::Request request;
+  std::string sent;
+  std::string received;
+  MessageParser<schema::Response> responses;
+};
+
+inline const std::string& Client::invoke(const schema::ProcedureCall& call,
+                                         InvokeBuffers& buffers) {
+  // Copying into the same message reuses the memory held by its fields
+  if (buffers.request.calls_size() == 0)
+    buffers.request.add_calls();
+  buffers.request.mutable_calls(0)->CopyFrom(call);
+  {
+    std::lock_guard<std::mutex> guard(*lock);
+    rpc_connection->send_message(buffers.request, buffers.sent);
+    rpc_connection->receive_message(buffers.received);
+  }
+  const schema::Response& response = buffers.responses.parse(buffers.received);
+  if (response.has_error())
+    throw_exception(response.error());
+  if (response.results_size() != 1)
+    throw RPCError("Request returned an unexpected number of results");
+  const schema::ProcedureResult& result = response.results(0);
+  if (result.has_error())
+    throw_exception(result.error());
+  return result.value();
+}
+
+}  // namespace krpc
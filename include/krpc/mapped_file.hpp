@@ -0,0 +1,242 @@
+#pragma once
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+namespace krpc {
+
+/**
+ * A file that is mapped into memory, and can be grown. Growing the file remaps it,
+ * so pointers into the data are invalidated.
+ */
+class MappedFile {
+ public:
+  /** Create a file, replacing any existing file, of the given size. */
+  MappedFile(const std::string& path, size_t size);
+  /** Map an existing file, such as one created by another process, in its entirety. */
+  explicit MappedFile(const std::string& path);
+  /** Unmaps and closes the file, if close() has not been called. */
+  ~MappedFile();
+  char * data();
+  size_t size() const;
+  /** Grow the file to at least the given size. */
+  void reserve(size_t size);
+  /** Write changes in the given range back to the file. */
+  void flush(size_t offset, size_t length);
+  /** Unmap the file and truncate it to the given size. */
+  void close(size_t size);
+
+ private:
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  void map(size_t size);
+  void unmap();
+  void fail(const std::string& operation) const;
+  std::string path;
+  char * address;
+  size_t length;
+#ifdef _WIN32
+  HANDLE file;
+  HANDLE mapping;
+#else
+  int file;
+#endif
+};
+
+#ifdef _WIN32
+
+inline MappedFile::MappedFile(const std::string& path, size_t size) :
+  path(path), address(nullptr), length(0), mapping(nullptr) {
+  // Shared for writing, so that other processes can map it with MappedFile(path)
+  file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE,
+                     FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, CREATE_ALWAYS,
+                     FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+    fail("open");
+  try {
+    map(size);
+  } catch (...) {
+    unmap();
+    CloseHandle(file);
+    throw;
+  }
+}
+
+inline MappedFile::MappedFile(const std::string& path) :
+  path(path), address(nullptr), length(0), mapping(nullptr) {
+  file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE,
+                     FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING,
+                     FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+    fail("open");
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+    CloseHandle(file);
+    fail("map");
+  }
+  try {
+    map(static_cast<size_t>(size.QuadPart));
+  } catch (...) {
+    unmap();
+    CloseHandle(file);
+    throw;
+  }
+}
+
+inline MappedFile::~MappedFile() {
+  unmap();
+  if (file != INVALID_HANDLE_VALUE)
+    CloseHandle(file);
+}
+
+inline void MappedFile::map(size_t size) {
+  // Creating a mapping larger than the file extends the file
+  ULARGE_INTEGER extent;
+  extent.QuadPart = size;
+  mapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE, extent.HighPart, extent.LowPart,
+                               nullptr);
+  if (!mapping)
+    fail("map");
+  address = static_cast<char*>(MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, size));
+  if (!address)
+    fail("map");
+  length = size;
+}
+
+inline void MappedFile::unmap() {
+  if (address)
+    UnmapViewOfFile(address);
+  if (mapping)
+    CloseHandle(mapping);
+  address = nullptr;
+  mapping = nullptr;
+  length = 0;
+}
+
+inline void MappedFile::flush(size_t offset, size_t length) {
+  if (address && length > 0)
+    FlushViewOfFile(address + offset, length);
+}
+
+inline void MappedFile::close(size_t size) {
+  unmap();
+  LARGE_INTEGER end;
+  end.QuadPart = size;
+  if (!SetFilePointerEx(file, end, nullptr, FILE_BEGIN) || !SetEndOfFile(file))
+    fail("truncate");
+  CloseHandle(file);
+  file = INVALID_HANDLE_VALUE;
+}
+
+#else
+
+inline MappedFile::MappedFile(const std::string& path, size_t size) :
+  path(path), address(nullptr), length(0) {
+  file = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (file < 0)
+    fail("open");
+  try {
+    map(size);
+  } catch (...) {
+    ::close(file);
+    throw;
+  }
+}
+
+inline MappedFile::MappedFile(const std::string& path) :
+  path(path), address(nullptr), length(0) {
+  file = ::open(path.c_str(), O_RDWR);
+  if (file < 0)
+    fail("open");
+  struct stat status;
+  if (fstat(file, &status) != 0 || status.st_size == 0) {
+    ::close(file);
+    fail("map");
+  }
+  void * result = mmap(nullptr, status.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+  if (result == MAP_FAILED) {
+    ::close(file);
+    fail("map");
+  }
+  address = static_cast<char*>(result);
+  length = status.st_size;
+}
+
+inline MappedFile::~MappedFile() {
+  unmap();
+  if (file >= 0)
+    ::close(file);
+}
+
+inline void MappedFile::map(size_t size) {
+  if (ftruncate(file, static_cast<off_t>(size)) != 0)
+    fail("resize");
+  void * result = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+  if (result == MAP_FAILED)
+    fail("map");
+  address = static_cast<char*>(result);
+  length = size;
+}
+
+inline void MappedFile::unmap() {
+  if (address)
+    munmap(address, length);
+  address = nullptr;
+  length = 0;
+}
+
+inline void MappedFile::flush(size_t offset, size_t length) {
+  if (!address || length == 0)
+    return;
+  // msync requires a page aligned address
+  size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  size_t start = offset - offset % page;
+  msync(address + start, length + offset - start, MS_ASYNC);
+}
+
+inline void MappedFile::close(size_t size) {
+  unmap();
+  if (ftruncate(file, static_cast<off_t>(size)) != 0)
+    fail("truncate");
+  ::close(file);
+  file = -1;
+}
+
+#endif
+
+inline char * MappedFile::data() {
+  return address;
+}
+
+inline size_t MappedFile::size() const {
+  return length;
+}
+
+inline void MappedFile::reserve(size_t size) {
+  if (size <= length)
+    return;
+  size_t next = length > 0 ? length : 1;
+  while (next < size)
+    next *= 2;
+  unmap();
+  map(next);
+}
+
+inline void MappedFile::fail(const std::string& operation) const {
+  throw std::runtime_error("Failed to " + operation + " file " + path);
+}
+
+}  // namespace krpc
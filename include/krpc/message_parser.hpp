@@ -0,0 +1,81 @@
+#pragma once
+
+#include <google/protobuf/stubs/port.h>
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+
+#include "krpc/error.hpp"
+
+namespace krpc {
+
+/** Counters of a MessageParser. */
+struct ParseStats {
+  /** Number of messages parsed */
+  google::protobuf::uint64 messages;
+  /** Total size of the messages parsed, in bytes */
+  google::protobuf::uint64 bytes;
+  /** Size of the largest message parsed, in bytes */
+  google::protobuf::uint64 largest;
+  /** Memory held by the reused message, measured after parsing the largest message */
+  google::protobuf::uint64 space_used;
+};
+
+/**
+ * Parses messages of type T into a single message object that is reused. Clearing a
+ * message keeps its sub-messages and the capacity of its strings and repeated fields, so
+ * once the largest message has been parsed, parsing messages of a similar shape no longer
+ * allocates memory. Not thread safe, except for stats().
+ */
+template <typename T>
+class MessageParser {
+ public:
+  MessageParser();
+  /**
+   * Parse a message. The message, and anything obtained from it, are valid until the
+   * next call to parse(). Throws EncodingError if the data is not a valid message.
+   */
+  T& parse(const char* data, size_t size);
+  T& parse(const std::string& data);
+  ParseStats stats() const;
+
+ private:
+  T message;
+  std::atomic<google::protobuf::uint64> messages;
+  std::atomic<google::protobuf::uint64> bytes;
+  std::atomic<google::protobuf::uint64> largest;
+  std::atomic<google::protobuf::uint64> space_used;
+};
+
+template <typename T> inline MessageParser<T>::MessageParser() :
+  messages(0), bytes(0), largest(0), space_used(0) {
+}
+
+template <typename T> inline T& MessageParser<T>::parse(const char* data, size_t size) {
+  // Clears the message before parsing, which keeps the memory it holds
+  if (!message.ParseFromArray(data, static_cast<int>(size)))
+    throw EncodingError("Failed to decode message");
+  messages++;
+  bytes += size;
+  if (size > largest) {
+    largest = size;
+    space_used = message.SpaceUsedLong();
+  }
+  return message;
+}
+
+template <typename T> inline T& MessageParser<T>::parse(const std::string& data) {
+  return parse(data.data(), data.size());
+}
+
+template <typename T> inline ParseStats MessageParser<T>::stats() const {
+  ParseStats result;
+  result.messages = messages;
+  result.bytes = bytes;
+  result.largest = largest;
+  result.space_used = space_used;
+  return result;
+}
+
+}  // namespace krpc
@@ -0,0 +1,713 @@
+#pragma once
+
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/stubs/port.h>
+
+#include <atomic>
+#include <chrono>  // NOLINT(build/c++11)
+#include <cstddef>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>  // NOLINT(build/c++11)
+#include <stdexcept>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <utility>
+#include <vector>
+
+#ifndef ASIO_STANDALONE
+#define ASIO_STANDALONE
+#endif
+#include <asio/connect.hpp>
+#include <asio/io_service.hpp>
+#include <asio/ip/tcp.hpp>
+#include <asio/steady_timer.hpp>
+#include <asio/write.hpp>
+
+#include "krpc/handshake.hpp"
+#include "krpc/krpc.pb.hpp"
+
+namespace krpc {
+
+/**
+ * The messages exchanged with a server during a session: the response to each request
+ * sent on the RPC connection, and the stream updates received on the stream connection,
+ * with the time they were received. Messages are held encoded, without their size.
+ */
+class RecordedSession {
+ public:
+  struct Exchange {
+    std::string request;
+    std::string response;
+  };
+  struct Update {
+    /** Seconds since the stream connection was made */
+    double time;
+    std::string update;
+  };
+  void add_exchange(const std::string& request, const std::string& response);
+  void add_exchange(const schema::Request& request, const schema::Response& response);
+  void add_update(double time, const std::string& update);
+  void add_update(double time, const schema::StreamUpdate& update);
+  const std::vector<Exchange>& exchanges() const;
+  const std::vector<Update>& updates() const;
+  /** Write the session to a file. */
+  void save(const std::string& path) const;
+  /** Read a session written by save(). */
+  static RecordedSession load(const std::string& path);
+
+ private:
+  static void write_string(std::ostream& stream, const std::string& data);
+  static std::string read_string(std::istream& stream);
+  std::vector<Exchange> exchange_list;
+  std::vector<Update> update_list;
+};
+
+/**
+ * A connection carrying size delimited messages, used by MockServer and RecordingProxy.
+ * Its operations run on the thread running its io_service.
+ */
+class MockChannel : public std::enable_shared_from_this<MockChannel> {
+ public:
+  typedef std::function<void(const std::string&)> MessageHandler;
+  typedef std::function<void()> Handler;
+  explicit MockChannel(asio::io_service& io_service);
+  asio::ip::tcp::socket& socket();
+  /**
+   * Start reading messages. on_message is called with each message, on_close when the
+   * connection is closed, and on_drained when all messages passed to send() have been
+   * written.
+   */
+  void start(const MessageHandler& on_message, const Handler& on_close,
+             const Handler& on_drained = nullptr);
+  /** Write a message, after the messages already queued. */
+  void send(const std::string& message);
+  size_t queued() const;
+  void close();
+  /** Add a channel to a list of channels, removing those that have been destroyed. */
+  static void track(std::vector<std::weak_ptr<MockChannel>>& channels,
+                    const std::shared_ptr<MockChannel>& channel);
+
+ private:
+  void read();
+  void write();
+  asio::ip::tcp::socket connection;
+  char chunk[4096];
+  std::string buffer;
+  std::deque<std::string> outgoing;
+  bool writing;
+  bool closed;
+  MessageHandler on_message;
+  Handler on_close;
+  Handler on_drained;
+};
+
+/** Options for a MockServer. */
+struct MockServerOptions {
+  MockServerOptions() : address("127.0.0.1"), rpc_port(0), stream_port(0), speed(1),
+                        repeat(false) {}
+  std::string address;
+  /** Ports to listen on. If zero, a free port is chosen. */
+  unsigned int rpc_port;
+  unsigned int stream_port;
+  /**
+   * How fast stream updates are replayed, relative to when they were recorded. If zero,
+   * each update is sent as soon as the previous one has been written.
+   */
+  double speed;
+  /** Whether to replay the stream updates again once they have all been sent */
+  bool repeat;
+};
+
+/** Counters for a MockServer. */
+struct MockServerStats {
+  google::protobuf::uint64 requests;
+  /** Number of requests that were not in the session, and were not handled */
+  google::protobuf::uint64 unmatched;
+  google::protobuf::uint64 updates;
+};
+
+/**
+ * A server on the loopback interface that speaks the kRPC protocol and replays a recorded
+ * session, so that clients can be tested and benchmarked without the game. Requests are
+ * answered with the response recorded for an identical request. A request that was
+ * recorded more than once gets the recorded responses in order, then the last one again.
+ * Stream updates are sent on each stream connection at the times they were recorded,
+ * scaled by the speed option, so a client that makes the same calls as the recorded
+ * session sees the same results.
+ */
+class MockServer {
+ public:
+  /**
+   * Handles a request that is not in the session. Returns false if it cannot, in which
+   * case the server returns an error.
+   */
+  typedef std::function<bool(const schema::Request&, schema::Response&)> Handler;
+  explicit MockServer(const RecordedSession& session,
+                      const MockServerOptions& options = MockServerOptions());
+  ~MockServer();
+  /** Set the handler for requests that are not in the session. */
+  void set_handler(const Handler& handler);
+  unsigned int rpc_port() const;
+  unsigned int stream_port() const;
+  MockServerStats stats() const;
+
+ private:
+  struct Responses {
+    std::vector<std::string> responses;
+    size_t next;
+  };
+  struct Replay {
+    std::shared_ptr<MockChannel> channel;
+    asio::steady_timer timer;
+    std::chrono::steady_clock::time_point start;
+    size_t next;
+    explicit Replay(asio::io_service& io_service) : timer(io_service), next(0) {}
+  };
+  MockServer(const MockServer&) = delete;
+  MockServer& operator=(const MockServer&) = delete;
+  void accept_rpc();
+  void accept_stream();
+  /** Returns false if the connection request is invalid. */
+  bool handshake(const std::shared_ptr<MockChannel>& channel, const std::string& message,
+                 schema::ConnectionRequest::Type type);
+  void respond(const std::shared_ptr<MockChannel>& channel, const std::string& message);
+  void replay(const std::shared_ptr<Replay>& replay);
+  MockServerOptions options;
+  std::map<std::string, Responses> responses;
+  /** Connections to close when the server is destroyed */
+  std::vector<std::weak_ptr<MockChannel>> channels;
+  std::vector<RecordedSession::Update> updates;
+  std::mutex handler_lock;
+  Handler handler;
+  std::atomic<google::protobuf::uint64> requests;
+  std::atomic<google::protobuf::uint64> unmatched;
+  std::atomic<google::protobuf::uint64> sent;
+  asio::io_service io_service;
+  asio::ip::tcp::acceptor rpc_acceptor;
+  asio::ip::tcp::acceptor stream_acceptor;
+  std::thread thread;
+};
+
+/**
+ * Records a session with a server, for replay by MockServer. Clients connect to the
+ * proxy's ports instead of the server's, and the proxy forwards messages in both
+ * directions, recording the requests, their responses, and the stream updates.
+ */
+class RecordingProxy {
+ public:
+  RecordingProxy(const std::string& address, unsigned int rpc_port, unsigned int stream_port,
+                 unsigned int local_rpc_port = 0, unsigned int local_stream_port = 0);
+  ~RecordingProxy();
+  unsigned int rpc_port() const;
+  unsigned int stream_port() const;
+  /** The session recorded so far. */
+  RecordedSession session() const;
+
+ private:
+  RecordingProxy(const RecordingProxy&) = delete;
+  RecordingProxy& operator=(const RecordingProxy&) = delete;
+  void accept(asio::ip::tcp::acceptor& acceptor, unsigned int port, bool stream);
+  /** Forward messages between a client and the server. */
+  void forward(const std::shared_ptr<MockChannel>& client, unsigned int port, bool stream);
+  std::string address;
+  unsigned int server_rpc_port;
+  unsigned int server_stream_port;
+  mutable std::mutex lock;
+  RecordedSession recorded;
+  /** Connections to close when the proxy is destroyed */
+  std::vector<std::weak_ptr<MockChannel>> channels;
+  asio::io_service io_service;
+  asio::ip::tcp::acceptor rpc_acceptor;
+  asio::ip::tcp::acceptor stream_acceptor;
+  std::thread thread;
+};
+
+inline void RecordedSession::add_exchange(const std::string& request,
+                                          const std::string& response) {
+  exchange_list.push_back(Exchange{request, response});
+}
+
+inline void RecordedSession::add_exchange(const schema::Request& request,
+                                          const schema::Response& response) {
+  add_exchange(request.SerializeAsString(), response.SerializeAsString());
+}
+
+inline void RecordedSession::add_update(double time, const std::string& update) {
+  update_list.push_back(Update{time, update});
+}
+
+inline void RecordedSession::add_update(double time, const schema::StreamUpdate& update) {
+  add_update(time, update.SerializeAsString());
+}
+
+inline const std::vector<RecordedSession::Exchange>& RecordedSession::exchanges() const {
+  return exchange_list;
+}
+
+inline const std::vector<RecordedSession::Update>& RecordedSession::updates() const {
+  return update_list;
+}
+
+inline void RecordedSession::save(const std::string& path) const {
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (!file)
+    throw std::runtime_error("Failed to open file " + path);
+  file.write("KRPCSES1", 8);
+  google::protobuf::uint64 counts[2] = {exchange_list.size(), update_list.size()};
+  file.write(reinterpret_cast<const char*>(counts), sizeof(counts));
+  for (auto& exchange : exchange_list) {
+    write_string(file, exchange.request);
+    write_string(file, exchange.response);
+  }
+  for (auto& update : update_list) {
+    file.write(reinterpret_cast<const char*>(&update.time), sizeof(update.time));
+    write_string(file, update.update);
+  }
+  if (!file)
+    throw std::runtime_error("Failed to write file " + path);
+}
+
+inline RecordedSession RecordedSession::load(const std::string& path) {
+  std::ifstream file(path, std::ios::binary);
+  char magic[8];
+  google::protobuf::uint64 counts[2];
+  if (!file.read(magic, 8) || std::memcmp(magic, "KRPCSES1", 8) != 0 ||
+      !file.read(reinterpret_cast<char*>(counts), sizeof(counts)))
+    throw std::runtime_error("Failed to read session from " + path);
+  RecordedSession session;
+  for (google::protobuf::uint64 i = 0; i < counts[0]; i++) {
+    std::string request = read_string(file);
+    session.add_exchange(request, read_string(file));
+  }
+  for (google::protobuf::uint64 i = 0; i < counts[1]; i++) {
+    double time;
+    file.read(reinterpret_cast<char*>(&time), sizeof(time));
+    session.add_update(time, read_string(file));
+  }
+  if (!file)
+    throw std::runtime_error("Failed to read session from " + path);
+  return session;
+}
+
+inline void RecordedSession::write_string(std::ostream& stream, const std::string& data) {
+  google::protobuf::uint64 size = data.size();
+  stream.write(reinterpret_cast<const char*>(&size), sizeof(size));
+  stream.write(data.data(), data.size());
+}
+
+inline std::string RecordedSession::read_string(std::istream& stream) {
+  google::protobuf::uint64 size = 0;
+  stream.read(reinterpret_cast<char*>(&size), sizeof(size));
+  if (!stream)
+    return std::string();
+  std::string data(size, '\0');
+  stream.read(&data[0], size);
+  return data;
+}
+
+inline MockChannel::MockChannel(asio::io_service& io_service) :
+  connection(io_service), writing(false), closed(false) {
+}
+
+inline asio::ip::tcp::socket& MockChannel::socket() {
+  return connection;
+}
+
+inline void MockChannel::start(const MessageHandler& on_message, const Handler& on_close,
+                               const Handler& on_drained) {
+  this->on_message = on_message;
+  this->on_close = on_close;
+  this->on_drained = on_drained;
+  read();
+}
+
+inline void MockChannel::send(const std::string& message) {
+  if (closed)
+    return;
+  google::protobuf::uint8 size[10];
+  google::protobuf::uint8 * end = google::protobuf::io::CodedOutputStream::WriteVarint32ToArray(
+    static_cast<google::protobuf::uint32>(message.size()), size);
+  std::string data(reinterpret_cast<char*>(size), end - size);
+  data.append(message);
+  outgoing.push_back(std::move(data));
+  if (!writing)
+    write();
+}
+
+inline size_t MockChannel::queued() const {
+  return outgoing.size();
+}
+
+inline void MockChannel::close() {
+  if (closed)
+    return;
+  closed = true;
+  asio::error_code error;
+  connection.shutdown(asio::ip::tcp::socket::shutdown_both, error);
+  connection.close(error);
+  // The message being written is referenced by the write until its handler runs
+  if (writing)
+    outgoing.erase(outgoing.begin() + 1, outgoing.end());
+  else
+    outgoing.clear();
+  Handler handler;
+  handler.swap(on_close);
+  on_message = nullptr;
+  on_drained = nullptr;
+  if (handler)
+    handler();
+}
+
+inline void MockChannel::read() {
+  std::shared_ptr<MockChannel> self = shared_from_this();
+  connection.async_read_some(
+    asio::buffer(chunk, sizeof(chunk)), [self] (const asio::error_code& error, size_t length) {
+      if (error) {
+        self->close();
+        return;
+      }
+      self->buffer.append(self->chunk, length);
+      while (!self->closed) {
+        // Each message is preceded by its size, as a varint
+        google::protobuf::uint64 size = 0;
+        size_t header = 0;
+        bool complete = false;
+        for (; header < self->buffer.size() && header < 10; header++) {
+          unsigned char byte = static_cast<unsigned char>(self->buffer[header]);
+          size |= static_cast<google::protobuf::uint64>(byte & 0x7f) << (7 * header);
+          if (!(byte & 0x80)) {
+            complete = true;
+            header++;
+            break;
+          }
+        }
+        if (!complete || self->buffer.size() < header + size)
+          break;
+        std::string message = self->buffer.substr(header, size);
+        self->buffer.erase(0, header + size);
+        self->on_message(message);
+      }
+      if (!self->closed)
+        self->read();
+    });
+}
+
+inline void MockChannel::write() {
+  if (outgoing.empty()) {
+    writing = false;
+    if (on_drained)
+      on_drained();
+    return;
+  }
+  writing = true;
+  std::shared_ptr<MockChannel> self = shared_from_this();
+  asio::async_write(connection, asio::buffer(outgoing.front()),
+                    [self] (const asio::error_code& error, size_t) {
+                      self->outgoing.pop_front();
+                      if (error || self->closed) {
+                        self->close();
+                        return;
+                      }
+                      self->write();
+                    });
+}
+
+inline void MockChannel::track(std::vector<std::weak_ptr<MockChannel>>& channels,
+                               const std::shared_ptr<MockChannel>& channel) {
+  for (auto it = channels.begin(); it != channels.end();) {
+    if (it->expired())
+      it = channels.erase(it);
+    else
+      ++it;
+  }
+  channels.push_back(channel);
+}
+
+inline MockServer::MockServer(const RecordedSession& session, const MockServerOptions& options) :
+  options(options), updates(session.updates()), requests(0), unmatched(0), sent(0),
+  rpc_acceptor(io_service), stream_acceptor(io_service) {
+  for (auto& exchange : session.exchanges()) {
+    Responses& recorded = responses[exchange.request];
+    recorded.responses.push_back(exchange.response);
+    recorded.next = 0;
+  }
+  asio::ip::address address = asio::ip::address::from_string(options.address);
+  asio::ip::tcp::endpoint rpc_endpoint(address, static_cast<uint16_t>(options.rpc_port));
+  asio::ip::tcp::endpoint stream_endpoint(address, static_cast<uint16_t>(options.stream_port));
+  rpc_acceptor.open(rpc_endpoint.protocol());
+  rpc_acceptor.set_option(asio::ip::tcp::acceptor::reuse_address(true));
+  rpc_acceptor.bind(rpc_endpoint);
+  rpc_acceptor.listen();
+  stream_acceptor.open(stream_endpoint.protocol());
+  stream_acceptor.set_option(asio::ip::tcp::acceptor::reuse_address(true));
+  stream_acceptor.bind(stream_endpoint);
+  stream_acceptor.listen();
+  accept_rpc();
+  accept_stream();
+  thread = std::thread([this] { io_service.run(); });
+}
+
+inline MockServer::~MockServer() {
+  // Closing the connections and acceptors cancels their operations, so run() returns
+  io_service.post([this] {
+    asio::error_code error;
+    rpc_acceptor.close(error);
+    stream_acceptor.close(error);
+    for (auto& channel : channels) {
+      if (std::shared_ptr<MockChannel> open = channel.lock())
+        open->close();
+    }
+  });
+  thread.join();
+}
+
+inline void MockServer::set_handler(const Handler& handler) {
+  std::lock_guard<std::mutex> guard(handler_lock);
+  this->handler = handler;
+}
+
+inline unsigned int MockServer::rpc_port() const {
+  return rpc_acceptor.local_endpoint().port();
+}
+
+inline unsigned int MockServer::stream_port() const {
+  return stream_acceptor.local_endpoint().port();
+}
+
+inline MockServerStats MockServer::stats() const {
+  MockServerStats result;
+  result.requests = requests;
+  result.unmatched = unmatched;
+  result.updates = sent;
+  return result;
+}
+
+inline void MockServer::accept_rpc() {
+  std::shared_ptr<MockChannel> channel = std::make_shared<MockChannel>(io_service);
+  rpc_acceptor.async_accept(channel->socket(), [this, channel] (const asio::error_code& error) {
+    if (error)
+      return;
+    MockChannel::track(channels, channel);
+    std::shared_ptr<bool> connected = std::make_shared<bool>(false);
+    std::weak_ptr<MockChannel> weak = channel;
+    channel->start([this, weak, connected] (const std::string& message) {
+      std::shared_ptr<MockChannel> channel = weak.lock();
+      if (!*connected)
+        *connected = handshake(channel, message, schema::ConnectionRequest::RPC);
+      else
+        respond(channel, message);
+    }, nullptr);
+    accept_rpc();
+  });
+}
+
+inline void MockServer::accept_stream() {
+  std::shared_ptr<MockChannel> channel = std::make_shared<MockChannel>(io_service);
+  stream_acceptor.async_accept(
+    channel->socket(), [this, channel] (const asio::error_code& error) {
+      if (error)
+        return;
+      MockChannel::track(channels, channel);
+      std::shared_ptr<Replay> replay = std::make_shared<Replay>(io_service);
+      std::weak_ptr<MockChannel> weak = channel;
+      channel->start([this, weak, replay] (const std::string& message) {
+        std::shared_ptr<MockChannel> channel = weak.lock();
+        if (replay->channel || !handshake(channel, message, schema::ConnectionRequest::STREAM))
+          return;
+        replay->channel = channel;
+        replay->start = std::chrono::steady_clock::now();
+        this->replay(replay);
+      }, [replay] {
+        asio::error_code error;
+        replay->timer.cancel(error);
+        replay->channel.reset();
+      }, [this, replay] {
+        // When replaying as fast as possible, the next update is sent once the
+        // previous one has been written
+        if (options.speed <= 0 && replay->channel)
+          this->replay(replay);
+      });
+      accept_stream();
+    });
+}
+
+inline bool MockServer::handshake(const std::shared_ptr<MockChannel>& channel,
+                                  const std::string& message,
+                                  schema::ConnectionRequest::Type type) {
+  schema::ConnectionResponse response = answer_connection_request(message, type);
+  channel->send(response.SerializeAsString());
+  return response.status() == schema::ConnectionResponse::OK;
+}
+
+inline void MockServer::respond(const std::shared_ptr<MockChannel>& channel,
+                                const std::string& message) {
+  requests++;
+  auto it = responses.find(message);
+  if (it != responses.end()) {
+    Responses& recorded = it->second;
+    channel->send(recorded.responses[recorded.next]);
+    if (recorded.next + 1 < recorded.responses.size())
+      recorded.next++;
+    return;
+  }
+  schema::Request request;
+  schema::Response response;
+  bool handled = false;
+  if (request.ParseFromString(message)) {
+    std::lock_guard<std::mutex> guard(handler_lock);
+    handled = handler && handler(request, response);
+  }
+  if (!handled) {
+    unmatched++;
+    response.Clear();
+    response.mutable_error()->set_description("No response was recorded for the request");
+  }
+  channel->send(response.SerializeAsString());
+}
+
+inline void MockServer::replay(const std::shared_ptr<Replay>& replay) {
+  if (!replay->channel)
+    return;
+  if (replay->next == updates.size()) {
+    if (!options.repeat || updates.empty())
+      return;
+    replay->next = 0;
+    replay->start = std::chrono::steady_clock::now();
+  }
+  const RecordedSession::Update& update = updates[replay->next];
+  if (options.speed <= 0) {
+    replay->next++;
+    sent++;
+    replay->channel->send(update.update);
+    return;
+  }
+  replay->timer.expires_at(
+    replay->start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+      std::chrono::duration<double>(update.time / options.speed)));
+  replay->timer.async_wait([this, replay] (const asio::error_code& error) {
+    if (error || !replay->channel)
+      return;
+    replay->channel->send(updates[replay->next].update);
+    replay->next++;
+    sent++;
+    this->replay(replay);
+  });
+}
+
+inline RecordingProxy::RecordingProxy(const std::string& address, unsigned int rpc_port,
+                                      unsigned int stream_port, unsigned int local_rpc_port,
+                                      unsigned int local_stream_port) :
+  address(address), server_rpc_port(rpc_port), server_stream_port(stream_port),
+  rpc_acceptor(io_service), stream_acceptor(io_service) {
+  asio::ip::address loopback = asio::ip::address::from_string("127.0.0.1");
+  asio::ip::tcp::endpoint rpc_endpoint(loopback, static_cast<uint16_t>(local_rpc_port));
+  asio::ip::tcp::endpoint stream_endpoint(loopback, static_cast<uint16_t>(local_stream_port));
+  rpc_acceptor.open(rpc_endpoint.protocol());
+  rpc_acceptor.set_option(asio::ip::tcp::acceptor::reuse_address(true));
+  rpc_acceptor.bind(rpc_endpoint);
+  rpc_acceptor.listen();
+  stream_acceptor.open(stream_endpoint.protocol());
+  stream_acceptor.set_option(asio::ip::tcp::acceptor::reuse_address(true));
+  stream_acceptor.bind(stream_endpoint);
+  stream_acceptor.listen();
+  accept(rpc_acceptor, server_rpc_port, false);
+  accept(stream_acceptor, server_stream_port, true);
+  thread = std::thread([this] { io_service.run(); });
+}
+
+inline RecordingProxy::~RecordingProxy() {
+  io_service.post([this] {
+    asio::error_code error;
+    rpc_acceptor.close(error);
+    stream_acceptor.close(error);
+    for (auto& channel : channels) {
+      if (std::shared_ptr<MockChannel> open = channel.lock())
+        open->close();
+    }
+  });
+  thread.join();
+}
+
+inline unsigned int RecordingProxy::rpc_port() const {
+  return rpc_acceptor.local_endpoint().port();
+}
+
+inline unsigned int RecordingProxy::stream_port() const {
+  return stream_acceptor.local_endpoint().port();
+}
+
+inline RecordedSession RecordingProxy::session() const {
+  std::lock_guard<std::mutex> guard(lock);
+  return recorded;
+}
+
+inline void RecordingProxy::accept(asio::ip::tcp::acceptor& acceptor, unsigned int port,
+                                   bool stream) {
+  std::shared_ptr<MockChannel> client = std::make_shared<MockChannel>(io_service);
+  acceptor.async_accept(client->socket(),
+                        [this, &acceptor, client, port, stream] (const asio::error_code& error) {
+                          if (error)
+                            return;
+                          forward(client, port, stream);
+                          accept(acceptor, port, stream);
+                        });
+}
+
+inline void RecordingProxy::forward(const std::shared_ptr<MockChannel>& client, unsigned int port,
+                                    bool stream) {
+  std::shared_ptr<MockChannel> server = std::make_shared<MockChannel>(io_service);
+  asio::ip::tcp::resolver resolver(io_service);
+  asio::error_code error;
+  asio::connect(server->socket(),
+                resolver.resolve(asio::ip::tcp::resolver::query(address, std::to_string(port))),
+                error);
+  if (error) {
+    client->close();
+    return;
+  }
+  MockChannel::track(channels, client);
+  MockChannel::track(channels, server);
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  // Requests waiting for a response. The first message in each direction is the
+  // connection handshake, which is not recorded.
+  std::shared_ptr<std::deque<std::string>> pending = std::make_shared<std::deque<std::string>>();
+  std::shared_ptr<bool> requested = std::make_shared<bool>(false);
+  std::shared_ptr<bool> accepted = std::make_shared<bool>(false);
+  std::weak_ptr<MockChannel> weak_client = client;
+  std::weak_ptr<MockChannel> weak_server = server;
+  client->start([weak_server, pending, requested] (const std::string& message) {
+    if (*requested)
+      pending->push_back(message);
+    *requested = true;
+    if (std::shared_ptr<MockChannel> server = weak_server.lock())
+      server->send(message);
+  }, [weak_server] {
+    if (std::shared_ptr<MockChannel> server = weak_server.lock())
+      server->close();
+  });
+  server->start([this, weak_client, pending, accepted, start, stream] (const std::string& message) {
+    if (*accepted) {
+      std::lock_guard<std::mutex> guard(lock);
+      if (stream) {
+        recorded.add_update(std::chrono::duration<double>(
+          std::chrono::steady_clock::now() - start).count(), message);
+      } else if (!pending->empty()) {
+        recorded.add_exchange(pending->front(), message);
+        pending->pop_front();
+      }
+    }
+    *accepted = true;
+    if (std::shared_ptr<MockChannel> client = weak_client.lock())
+      client->send(message);
+  }, [weak_client] {
+    if (std::shared_ptr<MockChannel> client = weak_client.lock())
+      client->close();
+  });
+}
+
+}  // namespace krpc
@@ -0,0 +1,269 @@
+#pragma once
+
+#include <condition_variable>  // NOLINT(build/c++11)
+#include <deque>
+#include <exception>
+#include <future>  // NOLINT(build/c++11)
+#include <memory>
+#include <mutex>  // NOLINT(build/c++11)
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <utility>
+
+#include "krpc/client.hpp"
+#include "krpc/connection.hpp"
+#include "krpc/connection_registry.hpp"
+#include "krpc/encoder.hpp"
+#include "krpc/error.hpp"
+#include "krpc/krpc.pb.hpp"
+#include "krpc/message_parser.hpp"
+
+namespace krpc {
+
+/**
+ * Pipelines procedure calls on a client's RPC connection. Requests are written to the
+ * connection as soon as they are made, and a receive thread matches the responses to
+ * requests in the order they were sent. While requests are in flight, the receive thread
+ * holds the client's lock, so blocking calls to Client::invoke wait for the pipeline to
+ * drain rather than interleaving with it.
+ */
+class Pipeline {
+ public:
+  typedef Client::ResultHandler Handler;
+  /** Returns the pipeline for a client's RPC connection, creating it if necessary. */
+  static std::shared_ptr<Pipeline> get(Client * client);
+  explicit Pipeline(Client * client);
+  ~Pipeline();
+  /** Send a call to the server. The handler is invoked on the receive thread. */
+  void invoke(Client * client, const schema::ProcedureCall& call, const Handler& handler);
+  /** Counters for the message that responses are parsed into. */
+  ParseStats parse_stats() const;
+
+ private:
+  struct Call {
+    Client * client;
+    Handler handler;
+    std::string data;
+  };
+  Pipeline(const Pipeline&) = delete;
+  Pipeline& operator=(const Pipeline&) = delete;
+  void receive_thread_main();
+  void drain();
+  std::deque<Call> abort();
+  static void fail(const std::deque<Call>& calls, const std::exception_ptr& exception);
+  void complete(const Call& call, const std::string& data);
+  std::weak_ptr<Connection> connection;
+  std::weak_ptr<std::mutex> client_lock;
+  /** Serializes writes to the connection */
+  std::mutex send_lock;
+  std::mutex lock;
+  std::condition_variable condition;
+  /** Calls waiting for the receive thread to acquire the connection */
+  std::deque<Call> queued;
+  /** Calls that have been sent, in the order they were sent */
+  std::deque<Call> in_flight;
+  /** Whether the receive thread holds the client's lock */
+  bool active;
+  bool stop;
+  std::thread receive_thread;
+  /** Parses responses on the receive thread, reusing memory */
+  MessageParser<schema::Response> responses;
+};
+
+inline std::future<std::string> Client::invoke_async(const schema::ProcedureCall& call) {
+  auto promise = std::make_shared<std::promise<std::string>>();
+  invoke_async(call, [promise] (const std::string& data, const std::exception_ptr& exception) {
+    if (exception)
+      promise->set_exception(exception);
+    else
+      promise->set_value(data);
+  });
+  return promise->get_future();
+}
+
+inline void Client::invoke_async(const schema::ProcedureCall& call, const ResultHandler& handler) {
+  Pipeline::get(this)->invoke(this, call, handler);
+}
+
+inline std::shared_ptr<Pipeline> Pipeline::get(Client * client) {
+  static ConnectionRegistry<Pipeline> pipelines;
+  return pipelines.get(client->rpc_connection, [client] {
+    return std::make_shared<Pipeline>(client);
+  });
+}
+
+inline Pipeline::Pipeline(Client * client) :
+  connection(client->rpc_connection), client_lock(client->lock), active(false), stop(false) {
+  receive_thread = std::thread(&Pipeline::receive_thread_main, this);
+}
+
+inline Pipeline::~Pipeline() {
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    stop = true;
+  }
+  condition.notify_all();
+  receive_thread.join();
+}
+
+inline void Pipeline::invoke(Client * client, const schema::ProcedureCall& call,
+                             const Handler& handler) {
+  schema::Request request;
+  request.add_calls()->CopyFrom(call);
+  Call entry = { client, handler, encoder::encode_message_with_size(request) };
+  std::unique_lock<std::mutex> send_guard(send_lock);
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    if (!active) {
+      queued.push_back(std::move(entry));
+      condition.notify_one();
+      return;
+    }
+    in_flight.push_back(Call{client, handler, std::string()});
+  }
+  try {
+    // The receive thread holds a reference to the connection while active
+    connection.lock()->send(entry.data);
+  } catch (...) {
+    // The caller gets the exception instead of the handler. The request may have been
+    // partly written, so responses can no longer be matched to calls: fail the others too.
+    {
+      std::lock_guard<std::mutex> guard(lock);
+      in_flight.pop_back();
+    }
+    std::deque<Call> failed = abort();
+    send_guard.unlock();
+    fail(failed, std::current_exception());
+    throw;
+  }
+}
+
+inline void Pipeline::receive_thread_main() {
+  std::unique_lock<std::mutex> guard(lock);
+  while (true) {
+    condition.wait(guard, [this] { return stop || !queued.empty(); });
+    if (queued.empty())
+      return;
+    guard.unlock();
+    drain();
+    guard.lock();
+  }
+}
+
+inline void Pipeline::drain() {
+  std::shared_ptr<Connection> connection = this->connection.lock();
+  std::shared_ptr<std::mutex> client_lock = this->client_lock.lock();
+  std::deque<Call> failed;
+  if (!connection || !client_lock) {
+    {
+      std::lock_guard<std::mutex> send_guard(send_lock);
+      failed = abort();
+    }
+    fail(failed, std::make_exception_ptr(ConnectionError("Connection was closed")));
+    return;
+  }
+  std::unique_lock<std::mutex> client_guard(*client_lock);
+  std::exception_ptr exception;
+  {
+    std::lock_guard<std::mutex> send_guard(send_lock);
+    std::deque<Call> calls;
+    {
+      std::lock_guard<std::mutex> guard(lock);
+      calls.swap(queued);
+      for (auto& call : calls)
+        in_flight.push_back(Call{call.client, call.handler, std::string()});
+      active = true;
+    }
+    try {
+      for (auto& call : calls)
+        connection->send(call.data);
+    } catch (...) {
+      exception = std::current_exception();
+      failed = abort();
+    }
+  }
+  if (exception) {
+    client_guard.unlock();
+    fail(failed, exception);
+    return;
+  }
+  while (true) {
+    std::string data;
+    try {
+      data = connection->receive_message();
+    } catch (...) {
+      exception = std::current_exception();
+      std::lock_guard<std::mutex> send_guard(send_lock);
+      failed = abort();
+    }
+    if (exception) {
+      client_guard.unlock();
+      fail(failed, exception);
+      return;
+    }
+    Call call;
+    {
+      std::lock_guard<std::mutex> guard(lock);
+      // The calls were failed when sending one of them failed
+      if (in_flight.empty())
+        return;
+      call = std::move(in_flight.front());
+      in_flight.pop_front();
+    }
+    complete(call, data);
+    std::lock_guard<std::mutex> guard(lock);
+    if (in_flight.empty()) {
+      active = false;
+      return;
+    }
+  }
+}
+
+inline ParseStats Pipeline::parse_stats() const {
+  return responses.stats();
+}
+
+/**
+ * Remove all outstanding calls, and return them so that they can be failed once the
+ * locks are released. The caller must hold send_lock.
+ */
+inline std::deque<Pipeline::Call> Pipeline::abort() {
+  std::deque<Call> failed;
+  std::lock_guard<std::mutex> guard(lock);
+  failed.swap(in_flight);
+  for (auto& call : queued)
+    failed.push_back(std::move(call));
+  queued.clear();
+  active = false;
+  return failed;
+}
+
+/**
+ * Invoke the handlers of calls that have failed. Must not be called while holding
+ * send_lock or the client's lock, as the handlers may make further calls.
+ */
+inline void Pipeline::fail(const std::deque<Call>& calls, const std::exception_ptr& exception) {
+  for (auto& call : calls)
+    call.handler(std::string(), exception);
+}
+
+inline void Pipeline::complete(const Call& call, const std::string& data) {
+  std::string value;
+  std::exception_ptr exception;
+  try {
+    schema::Response& response = responses.parse(data);
+    if (response.has_error())
+      call.client->throw_exception(response.error());
+    if (response.results_size() != 1)
+      throw RPCError("Response contains an unexpected number of results");
+    schema::ProcedureResult* result = response.mutable_results(0);
+    if (result->has_error())
+      call.client->throw_exception(result->error());
+    value.swap(*result->mutable_value());
+  } catch (...) {
+    exception = std::current_exception();
+  }
+  call.handler(value, exception);
+}
+
+}  // namespace krpc
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <google/protobuf/stubs/port.h>
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "krpc/connection_registry.hpp"
+#include "krpc/krpc.pb.hpp"
+
+namespace krpc {
+
+class Connection;
+
+/**
+ * Maps service and procedure names to the numeric IDs that the server accepts in
+ * ProcedureCall::service_id and ProcedureCall::procedure_id. The server numbers services,
+ * and the procedures within each service, from 1 in the order that they are listed by
+ * KRPC::get_services().
+ */
+class ProcedureTable {
+ public:
+  explicit ProcedureTable(const schema::Services& services);
+  /**
+   * Set the IDs of a procedure in a call, in place of its names.
+   * Returns false, and leaves the call unchanged, if the procedure is not known.
+   */
+  bool find(const char* service, const char* procedure, schema::ProcedureCall& call) const;
+  /** Replace the names in a call with numeric IDs, if the procedure is known. */
+  void compact(schema::ProcedureCall& call) const;
+  /** Returns the table used by an RPC connection, or nullptr if names are used. */
+  static std::shared_ptr<const ProcedureTable> get(const std::shared_ptr<Connection>& connection);
+  /** Set the table used by an RPC connection. Pass nullptr to send names again. */
+  static void set(const std::shared_ptr<Connection>& connection,
+                  const std::shared_ptr<const ProcedureTable>& table);
+
+ private:
+  typedef std::pair<std::string, google::protobuf::uint32> Entry;
+  struct Service {
+    std::string name;
+    google::protobuf::uint32 id;
+    std::vector<Entry> procedures;
+  };
+  static bool less(const Entry& entry, const char* name);
+  static ConnectionRegistry<const ProcedureTable>& registry();
+  std::vector<Service> services;
+};
+
+inline ProcedureTable::ProcedureTable(const schema::Services& services) {
+  for (int i = 0; i < services.services_size(); i++) {
+    const schema::Service& service = services.services(i);
+    Service entry;
+    entry.name = service.name();
+    entry.id = i + 1;
+    for (int j = 0; j < service.procedures_size(); j++)
+      entry.procedures.push_back(Entry(service.procedures(j).name(), j + 1));
+    std::sort(entry.procedures.begin(), entry.procedures.end());
+    this->services.push_back(entry);
+  }
+}
+
+inline bool ProcedureTable::find(const char* service, const char* procedure,
+                                 schema::ProcedureCall& call) const {
+  for (auto& entry : services) {
+    if (entry.name != service)
+      continue;
+    auto it = std::lower_bound(entry.procedures.begin(), entry.procedures.end(), procedure, less);
+    if (it == entry.procedures.end() || it->first != procedure)
+      return false;
+    call.clear_service();
+    call.clear_procedure();
+    call.set_service_id(entry.id);
+    call.set_procedure_id(it->second);
+    return true;
+  }
+  return false;
+}
+
+inline void ProcedureTable::compact(schema::ProcedureCall& call) const {
+  if (call.service().empty() || call.procedure().empty())
+    return;
+  const std::string service = call.service();
+  const std::string procedure = call.procedure();
+  find(service.c_str(), procedure.c_str(), call);
+}
+
+inline std::shared_ptr<const ProcedureTable> ProcedureTable::get(
+  const std::shared_ptr<Connection>& connection) {
+  return registry().get(connection);
+}
+
+inline void ProcedureTable::set(const std::shared_ptr<Connection>& connection,
+                                const std::shared_ptr<const ProcedureTable>& table) {
+  registry().set(connection, table);
+}
+
+inline bool ProcedureTable::less(const Entry& entry, const char* name) {
+  return std::strcmp(entry.first.c_str(), name) < 0;
+}
+
+inline ConnectionRegistry<const ProcedureTable>& ProcedureTable::registry() {
+  static ConnectionRegistry<const ProcedureTable> tables;
+  return tables;
+}
+
+}  // namespace krpc
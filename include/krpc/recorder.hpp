@@ -0,0 +1,403 @@
+#pragma once
+
+#include <google/protobuf/stubs/port.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>  // NOLINT(build/c++11)
+#include <condition_variable>  // NOLINT(build/c++11)
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>  // NOLINT(build/c++11)
+#include <stdexcept>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "krpc/client.hpp"
+#include "krpc/decoder.hpp"
+#include "krpc/mapped_file.hpp"
+#include "krpc/spsc_queue.hpp"
+#include "krpc/stream.hpp"
+#include "krpc/stream_impl.hpp"
+
+namespace krpc {
+
+/** A stream in the table at the start of a recording. */
+struct RecordingStream {
+  static const google::protobuf::uint32 value = 0;
+  static const google::protobuf::uint32 raw = 1;
+  google::protobuf::uint64 id;
+  /** value if the stream's updates are recorded as doubles, raw if as encoded bytes */
+  google::protobuf::uint32 encoding;
+  google::protobuf::uint32 reserved;
+  /** Name of the stream, null terminated */
+  char name[48];
+};
+
+/**
+ * The start of a recording. It is followed by chunks, each holding a RecordingChunk
+ * header then the columns of its updates:
+ *
+ *   uint64 ids[count]              Ids of the streams
+ *   int64  times[count]            Times the updates were received, in nanoseconds since
+ *                                  the epoch of the system clock
+ *   double values[count]           Values of streams recorded as doubles, otherwise NaN
+ *   uint64 offsets[count + 1]      Offsets into data of the updates of raw streams
+ *   char   data[data_size]         Encoded values of raw streams, padded to 8 bytes
+ *
+ * The chunk headers form an index: a reader can find the chunks that cover a period of
+ * time, or skip to the chunk it needs, by reading only the headers.
+ */
+struct RecordingHeader {
+  static const size_t max_streams = 64;
+  /** "KRPCREC" */
+  char magic[8];
+  google::protobuf::uint32 version;
+  google::protobuf::uint32 streams;
+  google::protobuf::uint64 chunks;
+  /** Offset of the end of the last chunk */
+  google::protobuf::uint64 end;
+  RecordingStream table[max_streams];
+};
+
+/** The header of a chunk of updates in a recording. */
+struct RecordingChunk {
+  /** "KRCH" */
+  char magic[4];
+  google::protobuf::uint32 count;
+  /** Size of the chunk, including this header */
+  google::protobuf::uint64 size;
+  google::protobuf::int64 first_time;
+  google::protobuf::int64 last_time;
+  google::protobuf::uint64 data_size;
+};
+
+/** Counters for a Recorder. */
+struct RecorderStats {
+  /** Number of updates queued for writing */
+  google::protobuf::uint64 recorded;
+  /** Number of updates discarded because the queue was full */
+  google::protobuf::uint64 dropped;
+  /** Number of updates written to the file */
+  google::protobuf::uint64 written;
+  google::protobuf::uint64 chunks;
+  /** Size of the recording, in bytes */
+  google::protobuf::uint64 bytes;
+};
+
+/**
+ * Records every update of a set of streams to a memory mapped file, in the columnar
+ * format described by RecordingHeader. The stream update thread copies each update into
+ * a preallocated queue, without taking a lock or allocating memory once the queue has
+ * warmed up, and a writer thread decodes the updates and appends them to the file in
+ * chunks. If the writer falls behind and the queue fills, updates are dropped rather than
+ * delaying the stream update thread, and counted in stats().
+ */
+class Recorder {
+ public:
+  /**
+   * Start recording to a file, replacing any existing file. queue_size is the number of
+   * updates that can be waiting to be written, and chunk_size the number of updates
+   * written in each chunk.
+   */
+  Recorder(Client * client, const std::string& path, size_t queue_size = 65536,
+           size_t chunk_size = 4096);
+  /** Stop recording, write the remaining updates, and close the file. */
+  ~Recorder();
+  /**
+   * Record the updates of a stream, from now on. Streams of numbers are recorded as
+   * doubles, and other streams as their encoded values. Starts the stream.
+   */
+  template <typename T> void record(const Stream<T>& stream, const std::string& name = "");
+  /** Wait until the updates recorded so far have been written to the file. */
+  void flush();
+  RecorderStats stats() const;
+
+ private:
+  struct Update {
+    google::protobuf::uint64 stream;
+    google::protobuf::int64 time;
+    std::string data;
+  };
+  typedef std::function<double(const std::string&)> Decoder;
+  struct Recorded {
+    std::shared_ptr<StreamImpl> impl;
+    int tag;
+    std::string name;
+    Decoder decode;
+    bool in_header;
+  };
+  /** Shared with the callbacks on the streams */
+  struct Queue {
+    explicit Queue(size_t size) : updates(size), recorded(0), dropped(0) {}
+    SpscQueue<Update> updates;
+    std::atomic<google::protobuf::uint64> recorded;
+    std::atomic<google::protobuf::uint64> dropped;
+  };
+  template <typename T, typename Enable = void> struct Decode {
+    static Decoder get(Client *) { return nullptr; }
+  };
+  template <typename T>
+  struct Decode<T, typename std::enable_if<std::is_arithmetic<T>::value>::type> {
+    static Decoder get(Client * client) {
+      return [client] (const std::string& data) {
+        T value;
+        decoder::decode(value, data.data(), data.size(), client);
+        return static_cast<double>(value);
+      };
+    }
+  };
+  Recorder(const Recorder&) = delete;
+  Recorder& operator=(const Recorder&) = delete;
+  void main();
+  void append(const Update& update);
+  void write_chunk();
+  void write_streams();
+  RecordingHeader& header();
+  Client * client;
+  std::shared_ptr<Queue> queue;
+  size_t chunk_size;
+  std::map<google::protobuf::uint64, Recorded> streams;
+  /** Protects streams, and the counters the writer thread shares with flush() */
+  mutable std::mutex lock;
+  std::condition_variable written_condition;
+  google::protobuf::uint64 written;
+  google::protobuf::uint64 chunks;
+  /** Number of updates flush() is waiting for */
+  google::protobuf::uint64 flush_target;
+  bool stop;
+  // Only accessed by the writer thread, after construction
+  MappedFile file;
+  google::protobuf::uint64 end;
+  std::vector<google::protobuf::uint64> ids;
+  std::vector<google::protobuf::int64> times;
+  std::vector<double> values;
+  std::vector<google::protobuf::uint64> offsets;
+  std::string data;
+  std::thread writer;
+};
+
+inline Recorder::Recorder(Client * client, const std::string& path, size_t queue_size,
+                          size_t chunk_size) :
+  client(client), queue(std::make_shared<Queue>(queue_size)),
+  chunk_size(std::max<size_t>(chunk_size, 1)), written(0), chunks(0), flush_target(0),
+  stop(false), file(path, 1 << 20), end(sizeof(RecordingHeader)) {
+  RecordingHeader& start = header();
+  std::memset(&start, 0, sizeof(RecordingHeader));
+  std::memcpy(start.magic, "KRPCREC", 8);
+  start.version = 1;
+  start.end = end;
+  ids.reserve(this->chunk_size);
+  times.reserve(this->chunk_size);
+  values.reserve(this->chunk_size);
+  offsets.reserve(this->chunk_size + 1);
+  writer = std::thread(&Recorder::main, this);
+}
+
+inline Recorder::~Recorder() {
+  std::map<google::protobuf::uint64, Recorded> recorded;
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    recorded = streams;
+  }
+  for (auto& stream : recorded)
+    stream.second.impl->remove_callback(stream.second.tag);
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    stop = true;
+  }
+  writer.join();
+  file.close(end);
+}
+
+template <typename T> inline void Recorder::record(const Stream<T>& stream,
+                                                   const std::string& name) {
+  Stream<T> recorded = stream;
+  recorded.check_exists();
+  recorded.start(false);
+  std::shared_ptr<StreamImpl> impl = recorded.impl;
+  google::protobuf::uint64 id = impl->get_id();
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    if (streams.count(id))
+      return;
+    if (streams.size() == RecordingHeader::max_streams)
+      throw std::length_error("Too many streams in recording");
+    streams[id] = Recorded{impl, -1, name, Decode<T>::get(client), false};
+  }
+  std::shared_ptr<Queue> queue = this->queue;
+  int tag = impl->add_callback([queue, id] (const std::string& data) {
+    Update * update = queue->updates.next();
+    if (!update) {
+      queue->dropped.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    update->stream = id;
+    update->time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::system_clock::now().time_since_epoch()).count();
+    // Reuses the memory held by the slot
+    update->data.assign(data);
+    queue->updates.push();
+    queue->recorded.fetch_add(1, std::memory_order_relaxed);
+  });
+  std::lock_guard<std::mutex> guard(lock);
+  streams[id].tag = tag;
+}
+
+inline void Recorder::flush() {
+  std::unique_lock<std::mutex> guard(lock);
+  google::protobuf::uint64 target = queue->recorded.load();
+  flush_target = std::max(flush_target, target);
+  written_condition.wait(guard, [this, target] { return written >= target; });
+}
+
+inline RecorderStats Recorder::stats() const {
+  RecorderStats result;
+  result.recorded = queue->recorded.load();
+  result.dropped = queue->dropped.load();
+  std::lock_guard<std::mutex> guard(lock);
+  result.written = written;
+  result.chunks = chunks;
+  // end is only written by the writer thread while holding the lock
+  result.bytes = end;
+  return result;
+}
+
+inline void Recorder::main() {
+  SpscQueue<Update>& updates = queue->updates;
+  while (true) {
+    Update * update = updates.front();
+    if (update) {
+      append(*update);
+      updates.pop();
+      if (ids.size() == chunk_size)
+        write_chunk();
+      continue;
+    }
+    bool stopping;
+    bool flushing;
+    {
+      std::lock_guard<std::mutex> guard(lock);
+      stopping = stop;
+      flushing = flush_target > written;
+    }
+    if (stopping) {
+      // The callbacks were removed before stopping, so nothing more can be queued
+      if (updates.front())
+        continue;
+      write_chunk();
+      return;
+    }
+    // Write a partial chunk if flush() is waiting for it
+    if (flushing && !ids.empty()) {
+      write_chunk();
+      continue;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+}
+
+inline void Recorder::append(const Update& update) {
+  Decoder decode;
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    auto it = streams.find(update.stream);
+    if (it != streams.end())
+      decode = it->second.decode;
+  }
+  double value = std::numeric_limits<double>::quiet_NaN();
+  if (offsets.empty())
+    offsets.push_back(0);
+  if (decode) {
+    try {
+      value = decode(update.data);
+    } catch (...) {
+      // Recorded as NaN, like the updates of raw streams
+    }
+  } else {
+    data.append(update.data);
+  }
+  ids.push_back(update.stream);
+  times.push_back(update.time);
+  values.push_back(value);
+  offsets.push_back(data.size());
+}
+
+inline void Recorder::write_chunk() {
+  write_streams();
+  size_t count = ids.size();
+  if (count == 0)
+    return;
+  size_t padded = (data.size() + 7) / 8 * 8;
+  size_t size = sizeof(RecordingChunk) + count * (3 * 8) + (count + 1) * 8 + padded;
+  file.reserve(end + size);
+  char * chunk = file.data() + end;
+  RecordingChunk head;
+  std::memcpy(head.magic, "KRCH", 4);
+  head.count = static_cast<google::protobuf::uint32>(count);
+  head.size = size;
+  head.first_time = times.front();
+  head.last_time = times.back();
+  head.data_size = data.size();
+  char * position = chunk;
+  std::memcpy(position, &head, sizeof(head));
+  position += sizeof(head);
+  std::memcpy(position, ids.data(), count * 8);
+  position += count * 8;
+  std::memcpy(position, times.data(), count * 8);
+  position += count * 8;
+  std::memcpy(position, values.data(), count * 8);
+  position += count * 8;
+  std::memcpy(position, offsets.data(), (count + 1) * 8);
+  position += (count + 1) * 8;
+  std::memcpy(position, data.data(), data.size());
+  std::memset(position + data.size(), 0, padded - data.size());
+  file.flush(end, size);
+  // Publish the chunk in the header once it has been written
+  RecordingHeader& start = header();
+  start.chunks++;
+  start.end = end + size;
+  file.flush(0, sizeof(RecordingHeader));
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    end += size;
+    chunks++;
+    written += count;
+  }
+  written_condition.notify_all();
+  ids.clear();
+  times.clear();
+  values.clear();
+  offsets.clear();
+  data.clear();
+}
+
+inline void Recorder::write_streams() {
+  RecordingHeader& start = header();
+  std::lock_guard<std::mutex> guard(lock);
+  for (auto& stream : streams) {
+    Recorded& recorded = stream.second;
+    if (recorded.in_header)
+      continue;
+    RecordingStream& entry = start.table[start.streams++];
+    entry.id = stream.first;
+    entry.encoding = recorded.decode ? RecordingStream::value : RecordingStream::raw;
+    size_t length = std::min(recorded.name.size(), sizeof(entry.name) - 1);
+    std::memcpy(entry.name, recorded.name.data(), length);
+    entry.name[length] = '\0';
+    recorded.in_header = true;
+  }
+}
+
+inline RecordingHeader& Recorder::header() {
+  return *reinterpret_cast<RecordingHeader*>(file.data());
+}
+
+}  // namespace krpc
@@ -0,0 +1,189 @@
+#pragma once
+
+#include <google/protobuf/stubs/port.h>
+
+#include <chrono>  // NOLINT(build/c++11)
+#include <condition_variable>  // NOLINT(build/c++11)
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>  // NOLINT(build/c++11)
+#include <vector>
+
+#include "krpc/client.hpp"
+#include "krpc/event.hpp"
+#include "krpc/stream.hpp"
+#include "krpc/stream_cache.hpp"
+
+namespace krpc {
+
+/**
+ * Waits for any or all of a set of events and streams, from a single thread. The
+ * selector is woken by the stream update thread once it has processed each stream
+ * update message, and then checks the values of the events and streams without
+ * taking their locks, so any number of them can be waited on without a thread each.
+ *
+ * An event is ready once it has occurred. A stream is ready once it has been updated
+ * since it was added, or since wait_any() last returned it, or, if it was added with
+ * a predicate, while the predicate holds for its most recent value.
+ */
+class Selector {
+ public:
+  explicit Selector(Client * client);
+  ~Selector();
+  /** Add an event. Starts it, and returns its index. */
+  size_t add(const Event& event);
+  /** Add a stream. Starts it, and returns its index. */
+  template <typename T> size_t add(const Stream<T>& stream);
+  /** Add a stream that is ready while predicate holds. Starts it, and returns its index. */
+  template <typename T> size_t add(const Stream<T>& stream,
+                                   const std::function<bool(const T&)>& predicate);
+  /** Stop waiting for an event or stream. Indices of the others are unchanged. */
+  void remove(size_t index);
+  /** Whether an event or stream is ready. */
+  bool ready(size_t index);
+  /**
+   * Wait until any of the events or streams are ready, and return the lowest index of
+   * those that are. Returns -1 if the operation times out, after timeout seconds if
+   * timeout >= 0, or if nothing has been added.
+   */
+  int wait_any(double timeout = -1);
+  /**
+   * Wait until all of the events and streams are ready. Returns false if the operation
+   * times out, after timeout seconds if timeout >= 0.
+   */
+  bool wait_all(double timeout = -1);
+
+ private:
+  struct Entry {
+    /** Whether the entry is ready, given the sequence number it was last returned at */
+    std::function<bool(google::protobuf::uint64& sequence)> check;
+    google::protobuf::uint64 sequence;
+    bool active;
+  };
+  struct State {
+    std::mutex lock;
+    std::condition_variable condition;
+  };
+  Selector(const Selector&) = delete;
+  Selector& operator=(const Selector&) = delete;
+  size_t add(const std::function<bool(google::protobuf::uint64&)>& check);
+  /** Wait until done returns true, or the timeout expires. */
+  bool wait(double timeout, const std::function<bool()>& done);
+  Client * client;
+  std::shared_ptr<State> state;
+  std::vector<Entry> entries;
+  int tag;
+};
+
+inline Selector::Selector(Client * client) :
+  client(client), state(std::make_shared<State>()) {
+  std::shared_ptr<State> state = this->state;
+  tag = client->add_stream_update_callback([state] {
+    // Taking the lock orders the notification after a waiter has checked the entries
+    { std::lock_guard<std::mutex> guard(state->lock); }
+    state->condition.notify_all();
+  });
+}
+
+inline Selector::~Selector() {
+  client->remove_stream_update_callback(tag);
+}
+
+inline size_t Selector::add(const Event& event) {
+  Stream<bool> stream = event.stream();
+  stream.start(false);
+  // The event's stream is constructed by the compiled library, so it has no cache holder
+  std::shared_ptr<StreamCache<bool>> cache = StreamCache<bool>::get(stream.impl.get());
+  return add([cache] (google::protobuf::uint64&) {
+    bool occurred = false;
+    return cache->load(occurred) && occurred;
+  });
+}
+
+template <typename T> inline size_t Selector::add(const Stream<T>& stream) {
+  Stream<T> added = stream;
+  added.start(false);
+  std::shared_ptr<StreamCache<T>> cache = added.cache();
+  google::protobuf::uint64 added_at = cache->sequence();
+  return add([cache, added_at] (google::protobuf::uint64& sequence) {
+    if (sequence < added_at)
+      sequence = added_at;
+    google::protobuf::uint64 current = cache->sequence();
+    if (current <= sequence)
+      return false;
+    sequence = current;
+    return true;
+  });
+}
+
+template <typename T> inline size_t Selector::add(
+  const Stream<T>& stream, const std::function<bool(const T&)>& predicate) {
+  Stream<T> added = stream;
+  added.start(false);
+  std::shared_ptr<StreamCache<T>> cache = added.cache();
+  return add([cache, predicate] (google::protobuf::uint64&) {
+    T value;
+    return cache->load(value) && predicate(value);
+  });
+}
+
+inline void Selector::remove(size_t index) {
+  std::lock_guard<std::mutex> guard(state->lock);
+  entries.at(index).active = false;
+}
+
+inline bool Selector::ready(size_t index) {
+  std::lock_guard<std::mutex> guard(state->lock);
+  Entry& entry = entries.at(index);
+  google::protobuf::uint64 sequence = entry.sequence;
+  return entry.active && entry.check(sequence);
+}
+
+inline int Selector::wait_any(double timeout) {
+  int result = -1;
+  wait(timeout, [this, &result] {
+    bool any = false;
+    for (size_t i = 0; i < entries.size(); i++) {
+      Entry& entry = entries[i];
+      if (!entry.active)
+        continue;
+      any = true;
+      if (entry.check(entry.sequence)) {
+        result = static_cast<int>(i);
+        return true;
+      }
+    }
+    return !any;
+  });
+  return result;
+}
+
+inline bool Selector::wait_all(double timeout) {
+  return wait(timeout, [this] {
+    for (auto& entry : entries) {
+      // Don't consume stream updates, so that wait_any() still sees them
+      google::protobuf::uint64 sequence = entry.sequence;
+      if (entry.active && !entry.check(sequence))
+        return false;
+    }
+    return true;
+  });
+}
+
+inline size_t Selector::add(const std::function<bool(google::protobuf::uint64&)>& check) {
+  std::lock_guard<std::mutex> guard(state->lock);
+  entries.push_back(Entry{check, 0, true});
+  return entries.size() - 1;
+}
+
+inline bool Selector::wait(double timeout, const std::function<bool()>& done) {
+  std::unique_lock<std::mutex> guard(state->lock);
+  if (timeout < 0) {
+    state->condition.wait(guard, done);
+    return true;
+  }
+  return state->condition.wait_for(guard, std::chrono::duration<double>(timeout), done);
+}
+
+}  // namespace krpc
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <google/protobuf/stubs/port.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <thread>  // NOLINT(build/c++11)
+#include <tuple>
+#include <type_traits>
+
+namespace krpc {
+
+/**
+ * Describes how to copy a value of type T to and from a flat buffer of bytes. Defined for
+ * arithmetic and enumeration types, and tuples of them, such as the vectors and quaternions
+ * returned by many procedures.
+ */
+template <typename T, typename Enable = void>
+struct PlainValue {
+  static const bool value = false;
+};
+
+template <typename T>
+struct PlainValue<T, typename std::enable_if<
+                       std::is_arithmetic<T>::value || std::is_enum<T>::value>::type> {
+  static const bool value = true;
+  static const size_t size = sizeof(T);
+  static void pack(const T& x, unsigned char* data) { std::memcpy(data, &x, sizeof(T)); }
+  static void unpack(const unsigned char* data, T& x) { std::memcpy(&x, data, sizeof(T)); }
+};
+
+/** Packs the elements of a tuple from index I onwards */
+template <typename Tuple, size_t I, size_t N>
+struct PlainTuple {
+  typedef typename std::tuple_element<I, Tuple>::type Element;
+  typedef PlainTuple<Tuple, I + 1, N> Rest;
+  static const bool value = PlainValue<Element>::value && Rest::value;
+  static const size_t size = PlainValue<Element>::size + Rest::size;
+  static void pack(const Tuple& x, unsigned char* data) {
+    PlainValue<Element>::pack(std::get<I>(x), data);
+    Rest::pack(x, data + PlainValue<Element>::size);
+  }
+  static void unpack(const unsigned char* data, Tuple& x) {
+    PlainValue<Element>::unpack(data, std::get<I>(x));
+    Rest::unpack(data + PlainValue<Element>::size, x);
+  }
+};
+
+template <typename Tuple, size_t N>
+struct PlainTuple<Tuple, N, N> {
+  static const bool value = true;
+  static const size_t size = 0;
+  static void pack(const Tuple&, unsigned char*) {}
+  static void unpack(const unsigned char*, Tuple&) {}
+};
+
+template <typename... Ts>
+struct PlainValue<std::tuple<Ts...>, typename std::enable_if<
+                                       PlainTuple<std::tuple<Ts...>, 0, sizeof...(Ts)>::value
+                                     >::type>
+  : PlainTuple<std::tuple<Ts...>, 0, sizeof...(Ts)> {
+};
+
+/**
+ * A sequence lock holding a value of type T, for which PlainValue<T> must be defined.
+ * There must be at most one writer at a time. Readers never block the writer, or each
+ * other; a read that overlaps a write is retried.
+ */
+template <typename T>
+class SeqLock {
+ public:
+  SeqLock();
+  /** Store a value. */
+  void store(const T& value);
+  /** Remove the value. */
+  void clear();
+  /** Copy the value. Returns false if there is no value. */
+  bool load(T& value) const;
+  /** Copy the value, and the version at which it was stored. */
+  bool load(T& value, google::protobuf::uint64& version) const;
+  /** The number of times the value has been stored or cleared. */
+  google::protobuf::uint64 version() const;
+
+ private:
+  static const size_t words = (PlainValue<T>::size + 7) / 8;
+  void write(const unsigned char* data, bool valid);
+  /** Odd while a write is in progress */
+  std::atomic<google::protobuf::uint64> sequence;
+  std::atomic<bool> valid;
+  std::atomic<google::protobuf::uint64> data[words];
+};
+
+template <typename T> inline SeqLock<T>::SeqLock() :
+  sequence(0), valid(false) {
+  for (size_t i = 0; i < words; i++)
+    data[i].store(0, std::memory_order_relaxed);
+}
+
+template <typename T> inline void SeqLock<T>::store(const T& value) {
+  unsigned char buffer[words * 8] = {};
+  PlainValue<T>::pack(value, buffer);
+  write(buffer, true);
+}
+
+template <typename T> inline void SeqLock<T>::clear() {
+  unsigned char buffer[words * 8] = {};
+  write(buffer, false);
+}
+
+template <typename T> inline void SeqLock<T>::write(const unsigned char* buffer, bool valid) {
+  google::protobuf::uint64 start = sequence.load(std::memory_order_relaxed);
+  sequence.store(start + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  this->valid.store(valid, std::memory_order_relaxed);
+  for (size_t i = 0; i < words; i++) {
+    google::protobuf::uint64 word;
+    std::memcpy(&word, buffer + i * 8, 8);
+    data[i].store(word, std::memory_order_relaxed);
+  }
+  sequence.store(start + 2, std::memory_order_release);
+}
+
+template <typename T> inline bool SeqLock<T>::load(T& value) const {
+  google::protobuf::uint64 version;
+  return load(value, version);
+}
+
+template <typename T> inline bool SeqLock<T>::load(
+  T& value, google::protobuf::uint64& version) const {
+  unsigned char buffer[words * 8];
+  bool valid;
+  while (true) {
+    google::protobuf::uint64 start = sequence.load(std::memory_order_acquire);
+    if (start & 1) {
+      std::this_thread::yield();
+      continue;
+    }
+    valid = this->valid.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < words; i++) {
+      google::protobuf::uint64 word = data[i].load(std::memory_order_relaxed);
+      std::memcpy(buffer + i * 8, &word, 8);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (sequence.load(std::memory_order_relaxed) == start) {
+      version = start / 2;
+      break;
+    }
+  }
+  if (valid)
+    PlainValue<T>::unpack(buffer, value);
+  return valid;
+}
+
+template <typename T> inline google::protobuf::uint64 SeqLock<T>::version() const {
+  return sequence.load(std::memory_order_acquire) / 2;
+}
+
+}  // namespace krpc
@@ -10,6 +10,7 @@
 #include <krpc/encoder.hpp>
 #include <krpc/error.hpp>
 #include <krpc/event.hpp>
+#include <krpc/future.hpp>
 #include <krpc/object.hpp>
 #include <krpc/service.hpp>
 #include <krpc/stream.hpp>
@@ -86,6 +87,16 @@ class Drawing : public Service {
 
   ::krpc::schema::ProcedureCall clear_call(bool client_only);
 
+  ::krpc::Future<Drawing::Line> add_direction_async(std::tuple<double, double, double> direction, SpaceCenter::ReferenceFrame reference_frame, float length, bool visible);
+
+  ::krpc::Future<Drawing::Line> add_line_async(std::tuple<double, double, double> start, std::tuple<double, double, double> end, SpaceCenter::ReferenceFrame reference_frame, bool visible);
+
+  ::krpc::Future<Drawing::Polygon> add_polygon_async(std::vector<std::tuple<double, double, double> > vertices, SpaceCenter::ReferenceFrame reference_frame, bool visible);
+
+  ::krpc::Future<Drawing::Text> add_text_async(std::string text, SpaceCenter::ReferenceFrame reference_frame, std::tuple<double, double, double> position, std::tuple<double, double, double, double> rotation, bool visible);
+
+  ::krpc::Future<void> clear_async(bool client_only);
+
   /**
    * A line. Created using Drawing::add_line.
    */
@@ -213,6 +224,36 @@ class Drawing : public Service {
     ::krpc::schema::ProcedureCall visible_call();
 
     ::krpc::schema::ProcedureCall set_visible_call(bool value);
+
+    ::krpc::Future<void> remove_async();
+
+    ::krpc::Future<std::tuple<double, double, double>> color_async();
+
+    ::krpc::Future<void> set_color_async(std::tuple<double, double, double> value);
+
+    ::krpc::Future<std::tuple<double, double, double>> end_async();
+
+    ::krpc::Future<void> set_end_async(std::tuple<double, double, double> value);
+
+    ::krpc::Future<std::string> material_async();
+
+    ::krpc::Future<void> set_material_async(std::string value);
+
+    ::krpc::Future<SpaceCenter::ReferenceFrame> reference_frame_async();
+
+    ::krpc::Future<void> set_reference_frame_async(SpaceCenter::ReferenceFrame value);
+
+    ::krpc::Future<std::tuple<double, double, double>> start_async();
+
+    ::krpc::Future<void> set_start_async(std::tuple<double, double, double> value);
+
+    ::krpc::Future<float> thickness_async();
+
+    ::krpc::Future<void> set_thickness_async(float value);
+
+    ::krpc::Future<bool> visible_async();
+
+    ::krpc::Future<void> set_visible_async(bool value);
   };
 
   /**
@@ -326,6 +367,32 @@ class Drawing : public Service {
     ::krpc::schema::ProcedureCall visible_call();
 
     ::krpc::schema::ProcedureCall set_visible_call(bool value);
+
+    ::krpc::Future<void> remove_async();
+
+    ::krpc::Future<std::tuple<double, double, double>> color_async();
+
+    ::krpc::Future<void> set_color_async(std::tuple<double, double, double> value);
+
+    ::krpc::Future<std::string> material_async();
+
+    ::krpc::Future<void> set_material_async(std::string value);
+
+    ::krpc::Future<SpaceCenter::ReferenceFrame> reference_frame_async();
+
+    ::krpc::Future<void> set_reference_frame_async(SpaceCenter::ReferenceFrame value);
+
+    ::krpc::Future<float> thickness_async();
+
+    ::krpc::Future<void> set_thickness_async(float value);
+
+    ::krpc::Future<std::vector<std::tuple<double, double, double> >> vertices_async();
+
+    ::krpc::Future<void> set_vertices_async(std::vector<std::tuple<double, double, double> > value);
+
+    ::krpc::Future<bool> visible_async();
+
+    ::krpc::Future<void> set_visible_async(bool value);
   };
 
   /**
@@ -576,6 +643,66 @@ class Drawing : public Service {
     ::krpc::schema::ProcedureCall visible_call();
 
     ::krpc::schema::ProcedureCall set_visible_call(bool value);
+
+    ::krpc::Future<void> remove_async();
+
+    static ::krpc::Future<std::vector<std::string>> available_fonts_async(Client& client);
+
+    ::krpc::Future<UI::TextAlignment> alignment_async();
+
+    ::krpc::Future<void> set_alignment_async(UI::TextAlignment value);
+
+    ::krpc::Future<UI::TextAnchor> anchor_async();
+
+    ::krpc::Future<void> set_anchor_async(UI::TextAnchor value);
+
+    ::krpc::Future<float> character_size_async();
+
+    ::krpc::Future<void> set_character_size_async(float value);
+
+    ::krpc::Future<std::tuple<double, double, double>> color_async();
+
+    ::krpc::Future<void> set_color_async(std::tuple<double, double, double> value);
+
+    ::krpc::Future<std::string> content_async();
+
+    ::krpc::Future<void> set_content_async(std::string value);
+
+    ::krpc::Future<std::string> font_async();
+
+    ::krpc::Future<void> set_font_async(std::string value);
+
+    ::krpc::Future<float> line_spacing_async();
+
+    ::krpc::Future<void> set_line_spacing_async(float value);
+
+    ::krpc::Future<std::string> material_async();
+
+    ::krpc::Future<void> set_material_async(std::string value);
+
+    ::krpc::Future<std::tuple<double, double, double>> position_async();
+
+    ::krpc::Future<void> set_position_async(std::tuple<double, double, double> value);
+
+    ::krpc::Future<SpaceCenter::ReferenceFrame> reference_frame_async();
+
+    ::krpc::Future<void> set_reference_frame_async(SpaceCenter::ReferenceFrame value);
+
+    ::krpc::Future<std::tuple<double, double, double, double>> rotation_async();
+
+    ::krpc::Future<void> set_rotation_async(std::tuple<double, double, double, double> value);
+
+    ::krpc::Future<int32_t> size_async();
+
+    ::krpc::Future<void> set_size_async(int32_t value);
+
+    ::krpc::Future<UI::FontStyle> style_async();
+
+    ::krpc::Future<void> set_style_async(UI::FontStyle value);
+
+    ::krpc::Future<bool> visible_async();
+
+    ::krpc::Future<void> set_visible_async(bool value);
   };
 };
 
@@ -719,6 +846,48 @@ inline ::krpc::schema::ProcedureCall Drawing::clear_call(bool client_only = fals
   return this->_client->build_call("Drawing", "Clear", _args);
 }
 
+inline ::krpc::Future<Drawing::Line> Drawing::add_direction_async(std::tuple<double, double, double> direction, SpaceCenter::ReferenceFrame reference_frame, float length = 10.0, bool visible = true) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(direction));
+  _args.push_back(encoder::encode(reference_frame));
+  _args.push_back(encoder::encode(length));
+  _args.push_back(encoder::encode(visible));
+  return ::krpc::Future<Drawing::Line>(this->_client, this->_client->build_call("Drawing", "AddDirection", _args), [] (Drawing::Line& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<Drawing::Line> Drawing::add_line_async(std::tuple<double, double, double> start, std::tuple<double, double, double> end, SpaceCenter::ReferenceFrame reference_frame, bool visible = true) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(start));
+  _args.push_back(encoder::encode(end));
+  _args.push_back(encoder::encode(reference_frame));
+  _args.push_back(encoder::encode(visible));
+  return ::krpc::Future<Drawing::Line>(this->_client, this->_client->build_call("Drawing", "AddLine", _args), [] (Drawing::Line& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<Drawing::Polygon> Drawing::add_polygon_async(std::vector<std::tuple<double, double, double> > vertices, SpaceCenter::ReferenceFrame reference_frame, bool visible = true) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(vertices));
+  _args.push_back(encoder::encode(reference_frame));
+  _args.push_back(encoder::encode(visible));
+  return ::krpc::Future<Drawing::Polygon>(this->_client, this->_client->build_call("Drawing", "AddPolygon", _args), [] (Drawing::Polygon& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<Drawing::Text> Drawing::add_text_async(std::string text, SpaceCenter::ReferenceFrame reference_frame, std::tuple<double, double, double> position, std::tuple<double, double, double, double> rotation, bool visible = true) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(text));
+  _args.push_back(encoder::encode(reference_frame));
+  _args.push_back(encoder::encode(position));
+  _args.push_back(encoder::encode(rotation));
+  _args.push_back(encoder::encode(visible));
+  return ::krpc::Future<Drawing::Text>(this->_client, this->_client->build_call("Drawing", "AddText", _args), [] (Drawing::Text& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> Drawing::clear_async(bool client_only = false) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(client_only));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("Drawing", "Clear", _args));
+}
+
 inline Drawing::Line::Line(Client* client, uint64_t id):
   Object(client, "Drawing::Line", id) {}
 
@@ -979,6 +1148,103 @@ inline ::krpc::schema::ProcedureCall Drawing::Line::set_visible_call(bool value)
   return this->_client->build_call("Drawing", "Line_set_Visible", _args);
 }
 
+inline ::krpc::Future<void> Drawing::Line::remove_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("Drawing", "Line_Remove", _args));
+}
+
+inline ::krpc::Future<std::tuple<double, double, double>> Drawing::Line::color_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<std::tuple<double, double, double>>(this->_client, this->_client->build_call("Drawing", "Line_get_Color", _args), [] (std::tuple<double, double, double>& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> Drawing::Line::set_color_async(std::tuple<double, double, double> value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("Drawing", "Line_set_Color", _args));
+}
+
+inline ::krpc::Future<std::tuple<double, double, double>> Drawing::Line::end_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<std::tuple<double, double, double>>(this->_client, this->_client->build_call("Drawing", "Line_get_End", _args), [] (std::tuple<double, double, double>& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> Drawing::Line::set_end_async(std::tuple<double, double, double> value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("Drawing", "Line_set_End", _args));
+}
+
+inline ::krpc::Future<std::string> Drawing::Line::material_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<std::string>(this->_client, this->_client->build_call("Drawing", "Line_get_Material", _args), [] (std::string& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> Drawing::Line::set_material_async(std::string value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("Drawing", "Line_set_Material", _args));
+}
+
+inline ::krpc::Future<SpaceCenter::ReferenceFrame> Drawing::Line::reference_frame_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<SpaceCenter::ReferenceFrame>(this->_client, this->_client->build_call("Drawing", "Line_get_ReferenceFrame", _args), [] (SpaceCenter::ReferenceFrame& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> Drawing::Line::set_reference_frame_async(SpaceCenter::ReferenceFrame value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("Drawing", "Line_set_ReferenceFrame", _args));
+}
+
+inline ::krpc::Future<std::tuple<double, double, double>> Drawing::Line::start_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<std::tuple<double, double, double>>(this->_client, this->_client->build_call("Drawing", "Line_get_Start", _args), [] (std::tuple<double, double, double>& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> Drawing::Line::set_start_async(std::tuple<double, double, double> value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("Drawing", "Line_set_Start", _args));
+}
+
+inline ::krpc::Future<float> Drawing::Line::thickness_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<float>(this->_client, this->_client->build_call("Drawing", "Line_get_Thickness", _args), [] (float& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> Drawing::Line::set_thickness_async(float value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("Drawing", "Line_set_Thickness", _args));
+}
+
+inline ::krpc::Future<bool> Drawing::Line::visible_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<bool>(this->_client, this->_client->build_call("Drawing", "Line_get_Visible", _args), [] (bool& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> Drawing::Line::set_visible_async(bool value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("Drawing", "Line_set_Visible", _args));
+}
+
 inline Drawing::Polygon::Polygon(Client* client, uint64_t id):
   Object(client, "Drawing::Polygon", id) {}
 
@@ -1204,6 +1470,90 @@ inline ::krpc::schema::ProcedureCall Drawing::Polygon::set_visible_call(bool val
   return this->_client->build_call("Drawing", "Polygon_set_Visible", _args);
 }
 
+inline ::krpc::Future<void> Drawing::Polygon::remove_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("Drawing", "Polygon_Remove", _args));
+}
+
+inline ::krpc::Future<std::tuple<double, double, double>> Drawing::Polygon::color_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<std::tuple<double, double, double>>(this->_client, this->_client->build_call("Drawing", "Polygon_get_Color", _args), [] (std::tuple<double, double, double>& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> Drawing::Polygon::set_color_async(std::tuple<double, double, double> value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("Drawing", "Polygon_set_Color", _args));
+}
+
+inline ::krpc::Future<std::string> Drawing::Polygon::material_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<std::string>(this->_client, this->_client->build_call("Drawing", "Polygon_get_Material", _args), [] (std::string& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> Drawing::Polygon::set_material_async(std::string value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("Drawing", "Polygon_set_Material", _args));
+}
+
+inline ::krpc::Future<SpaceCenter::ReferenceFrame> Drawing::Polygon::reference_frame_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<SpaceCenter::ReferenceFrame>(this->_client, this->_client->build_call("Drawing", "Polygon_get_ReferenceFrame", _args), [] (SpaceCenter::ReferenceFrame& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> Drawing::Polygon::set_reference_frame_async(SpaceCenter::ReferenceFrame value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("Drawing", "Polygon_set_ReferenceFrame", _args));
+}
+
+inline ::krpc::Future<float> Drawing::Polygon::thickness_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<float>(this->_client, this->_client->build_call("Drawing", "Polygon_get_Thickness", _args), [] (float& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> Drawing::Polygon::set_thickness_async(float value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("Drawing", "Polygon_set_Thickness", _args));
+}
+
+inline ::krpc::Future<std::vector<std::tuple<double, double, double> >> Drawing::Polygon::vertices_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<std::vector<std::tuple<double, double, double> >>(this->_client, this->_client->build_call("Drawing", "Polygon_get_Vertices", _args), [] (std::vector<std::tuple<double, double, double> >& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> Drawing::Polygon::set_vertices_async(std::vector<std::tuple<double, double, double> > value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("Drawing", "Polygon_set_Vertices", _args));
+}
+
+inline ::krpc::Future<bool> Drawing::Polygon::visible_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<bool>(this->_client, this->_client->build_call("Drawing", "Polygon_get_Visible", _args), [] (bool& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> Drawing::Polygon::set_visible_async(bool value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("Drawing", "Polygon_set_Visible", _args));
+}
+
 inline Drawing::Text::Text(Client* client, uint64_t id):
   Object(client, "Drawing::Text", id) {}
 
@@ -1723,6 +2073,198 @@ inline ::krpc::schema::ProcedureCall Drawing::Text::set_visible_call(bool value)
 inline ::krpc::schema::ProcedureCall Drawing::Text::available_fonts_call(Client& _client) {
   return _client.build_call("Drawing", "Text_static_AvailableFonts");
 }
+
+inline ::krpc::Future<void> Drawing::Text::remove_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("Drawing", "Text_Remove", _args));
+}
+
+inline ::krpc::Future<UI::TextAlignment> Drawing::Text::alignment_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<UI::TextAlignment>(this->_client, this->_client->build_call("Drawing", "Text_get_Alignment", _args), [] (UI::TextAlignment& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> Drawing::Text::set_alignment_async(UI::TextAlignment value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("Drawing", "Text_set_Alignment", _args));
+}
+
+inline ::krpc::Future<UI::TextAnchor> Drawing::Text::anchor_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<UI::TextAnchor>(this->_client, this->_client->build_call("Drawing", "Text_get_Anchor", _args), [] (UI::TextAnchor& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> Drawing::Text::set_anchor_async(UI::TextAnchor value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("Drawing", "Text_set_Anchor", _args));
+}
+
+inline ::krpc::Future<float> Drawing::Text::character_size_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<float>(this->_client, this->_client->build_call("Drawing", "Text_get_CharacterSize", _args), [] (float& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> Drawing::Text::set_character_size_async(float value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("Drawing", "Text_set_CharacterSize", _args));
+}
+
+inline ::krpc::Future<std::tuple<double, double, double>> Drawing::Text::color_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<std::tuple<double, double, double>>(this->_client, this->_client->build_call("Drawing", "Text_get_Color", _args), [] (std::tuple<double, double, double>& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> Drawing::Text::set_color_async(std::tuple<double, double, double> value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("Drawing", "Text_set_Color", _args));
+}
+
+inline ::krpc::Future<std::string> Drawing::Text::content_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<std::string>(this->_client, this->_client->build_call("Drawing", "Text_get_Content", _args), [] (std::string& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> Drawing::Text::set_content_async(std::string value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("Drawing", "Text_set_Content", _args));
+}
+
+inline ::krpc::Future<std::string> Drawing::Text::font_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<std::string>(this->_client, this->_client->build_call("Drawing", "Text_get_Font", _args), [] (std::string& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> Drawing::Text::set_font_async(std::string value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("Drawing", "Text_set_Font", _args));
+}
+
+inline ::krpc::Future<float> Drawing::Text::line_spacing_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<float>(this->_client, this->_client->build_call("Drawing", "Text_get_LineSpacing", _args), [] (float& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> Drawing::Text::set_line_spacing_async(float value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("Drawing", "Text_set_LineSpacing", _args));
+}
+
+inline ::krpc::Future<std::string> Drawing::Text::material_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<std::string>(this->_client, this->_client->build_call("Drawing", "Text_get_Material", _args), [] (std::string& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> Drawing::Text::set_material_async(std::string value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("Drawing", "Text_set_Material", _args));
+}
+
+inline ::krpc::Future<std::tuple<double, double, double>> Drawing::Text::position_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<std::tuple<double, double, double>>(this->_client, this->_client->build_call("Drawing", "Text_get_Position", _args), [] (std::tuple<double, double, double>& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> Drawing::Text::set_position_async(std::tuple<double, double, double> value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("Drawing", "Text_set_Position", _args));
+}
+
+inline ::krpc::Future<SpaceCenter::ReferenceFrame> Drawing::Text::reference_frame_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<SpaceCenter::ReferenceFrame>(this->_client, this->_client->build_call("Drawing", "Text_get_ReferenceFrame", _args), [] (SpaceCenter::ReferenceFrame& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> Drawing::Text::set_reference_frame_async(SpaceCenter::ReferenceFrame value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("Drawing", "Text_set_ReferenceFrame", _args));
+}
+
+inline ::krpc::Future<std::tuple<double, double, double, double>> Drawing::Text::rotation_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<std::tuple<double, double, double, double>>(this->_client, this->_client->build_call("Drawing", "Text_get_Rotation", _args), [] (std::tuple<double, double, double, double>& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> Drawing::Text::set_rotation_async(std::tuple<double, double, double, double> value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("Drawing", "Text_set_Rotation", _args));
+}
+
+inline ::krpc::Future<int32_t> Drawing::Text::size_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<int32_t>(this->_client, this->_client->build_call("Drawing", "Text_get_Size", _args), [] (int32_t& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> Drawing::Text::set_size_async(int32_t value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("Drawing", "Text_set_Size", _args));
+}
+
+inline ::krpc::Future<UI::FontStyle> Drawing::Text::style_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<UI::FontStyle>(this->_client, this->_client->build_call("Drawing", "Text_get_Style", _args), [] (UI::FontStyle& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> Drawing::Text::set_style_async(UI::FontStyle value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("Drawing", "Text_set_Style", _args));
+}
+
+inline ::krpc::Future<bool> Drawing::Text::visible_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<bool>(this->_client, this->_client->build_call("Drawing", "Text_get_Visible", _args), [] (bool& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> Drawing::Text::set_visible_async(bool value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("Drawing", "Text_set_Visible", _args));
+}
+
+inline ::krpc::Future<std::vector<std::string>> Drawing::Text::available_fonts_async(Client& _client) {
+  return ::krpc::Future<std::vector<std::string>>(&_client, _client.build_call("Drawing", "Text_static_AvailableFonts"), [] (std::vector<std::string>& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
 }  // namespace services
 
 }  // namespace krpc
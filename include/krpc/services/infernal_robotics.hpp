@@ -10,6 +10,7 @@
 #include <krpc/encoder.hpp>
 #include <krpc/error.hpp>
 #include <krpc/event.hpp>
+#include <krpc/future.hpp>
 #include <krpc/object.hpp>
 #include <krpc/service.hpp>
 #include <krpc/stream.hpp>
@@ -76,6 +77,16 @@ class InfernalRobotics : public Service {
 
   ::krpc::schema::ProcedureCall ready_call();
 
+  ::krpc::Future<InfernalRobotics::ServoGroup> servo_group_with_name_async(SpaceCenter::Vessel vessel, std::string name);
+
+  ::krpc::Future<std::vector<InfernalRobotics::ServoGroup>> servo_groups_async(SpaceCenter::Vessel vessel);
+
+  ::krpc::Future<InfernalRobotics::Servo> servo_with_name_async(SpaceCenter::Vessel vessel, std::string name);
+
+  ::krpc::Future<bool> available_async();
+
+  ::krpc::Future<bool> ready_async();
+
   /**
    * Represents a servo. Obtained using
    * InfernalRobotics::ServoGroup::servos,
@@ -335,6 +346,68 @@ class InfernalRobotics : public Service {
     ::krpc::schema::ProcedureCall speed_call();
 
     ::krpc::schema::ProcedureCall set_speed_call(float value);
+
+    ::krpc::Future<void> move_center_async();
+
+    ::krpc::Future<void> move_left_async();
+
+    ::krpc::Future<void> move_next_preset_async();
+
+    ::krpc::Future<void> move_prev_preset_async();
+
+    ::krpc::Future<void> move_right_async();
+
+    ::krpc::Future<void> move_to_async(float position, float speed);
+
+    ::krpc::Future<void> stop_async();
+
+    ::krpc::Future<float> acceleration_async();
+
+    ::krpc::Future<void> set_acceleration_async(float value);
+
+    ::krpc::Future<float> config_speed_async();
+
+    ::krpc::Future<float> current_speed_async();
+
+    ::krpc::Future<void> set_current_speed_async(float value);
+
+    ::krpc::Future<void> set_highlight_async(bool value);
+
+    ::krpc::Future<bool> is_axis_inverted_async();
+
+    ::krpc::Future<void> set_is_axis_inverted_async(bool value);
+
+    ::krpc::Future<bool> is_free_moving_async();
+
+    ::krpc::Future<bool> is_locked_async();
+
+    ::krpc::Future<void> set_is_locked_async(bool value);
+
+    ::krpc::Future<bool> is_moving_async();
+
+    ::krpc::Future<float> max_config_position_async();
+
+    ::krpc::Future<float> max_position_async();
+
+    ::krpc::Future<void> set_max_position_async(float value);
+
+    ::krpc::Future<float> min_config_position_async();
+
+    ::krpc::Future<float> min_position_async();
+
+    ::krpc::Future<void> set_min_position_async(float value);
+
+    ::krpc::Future<std::string> name_async();
+
+    ::krpc::Future<void> set_name_async(std::string value);
+
+    ::krpc::Future<SpaceCenter::Part> part_async();
+
+    ::krpc::Future<float> position_async();
+
+    ::krpc::Future<float> speed_async();
+
+    ::krpc::Future<void> set_speed_async(float value);
   };
 
   /**
@@ -496,6 +569,44 @@ class InfernalRobotics : public Service {
     ::krpc::schema::ProcedureCall speed_call();
 
     ::krpc::schema::ProcedureCall set_speed_call(float value);
+
+    ::krpc::Future<void> move_center_async();
+
+    ::krpc::Future<void> move_left_async();
+
+    ::krpc::Future<void> move_next_preset_async();
+
+    ::krpc::Future<void> move_prev_preset_async();
+
+    ::krpc::Future<void> move_right_async();
+
+    ::krpc::Future<InfernalRobotics::Servo> servo_with_name_async(std::string name);
+
+    ::krpc::Future<void> stop_async();
+
+    ::krpc::Future<bool> expanded_async();
+
+    ::krpc::Future<void> set_expanded_async(bool value);
+
+    ::krpc::Future<std::string> forward_key_async();
+
+    ::krpc::Future<void> set_forward_key_async(std::string value);
+
+    ::krpc::Future<std::string> name_async();
+
+    ::krpc::Future<void> set_name_async(std::string value);
+
+    ::krpc::Future<std::vector<SpaceCenter::Part>> parts_async();
+
+    ::krpc::Future<std::string> reverse_key_async();
+
+    ::krpc::Future<void> set_reverse_key_async(std::string value);
+
+    ::krpc::Future<std::vector<InfernalRobotics::Servo>> servos_async();
+
+    ::krpc::Future<float> speed_async();
+
+    ::krpc::Future<void> set_speed_async(float value);
   };
 };
 
@@ -606,6 +717,34 @@ inline ::krpc::schema::ProcedureCall InfernalRobotics::ready_call() {
   return this->_client->build_call("InfernalRobotics", "get_Ready");
 }
 
+inline ::krpc::Future<InfernalRobotics::ServoGroup> InfernalRobotics::servo_group_with_name_async(SpaceCenter::Vessel vessel, std::string name) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(vessel));
+  _args.push_back(encoder::encode(name));
+  return ::krpc::Future<InfernalRobotics::ServoGroup>(this->_client, this->_client->build_call("InfernalRobotics", "ServoGroupWithName", _args), [] (InfernalRobotics::ServoGroup& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<std::vector<InfernalRobotics::ServoGroup>> InfernalRobotics::servo_groups_async(SpaceCenter::Vessel vessel) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(vessel));
+  return ::krpc::Future<std::vector<InfernalRobotics::ServoGroup>>(this->_client, this->_client->build_call("InfernalRobotics", "ServoGroups", _args), [] (std::vector<InfernalRobotics::ServoGroup>& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<InfernalRobotics::Servo> InfernalRobotics::servo_with_name_async(SpaceCenter::Vessel vessel, std::string name) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(vessel));
+  _args.push_back(encoder::encode(name));
+  return ::krpc::Future<InfernalRobotics::Servo>(this->_client, this->_client->build_call("InfernalRobotics", "ServoWithName", _args), [] (InfernalRobotics::Servo& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<bool> InfernalRobotics::available_async() {
+  return ::krpc::Future<bool>(this->_client, this->_client->build_call("InfernalRobotics", "get_Available"), [] (bool& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<bool> InfernalRobotics::ready_async() {
+  return ::krpc::Future<bool>(this->_client, this->_client->build_call("InfernalRobotics", "get_Ready"), [] (bool& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
 inline InfernalRobotics::Servo::Servo(Client* client, uint64_t id):
   Object(client, "InfernalRobotics::Servo", id) {}
 
@@ -1138,6 +1277,203 @@ inline ::krpc::schema::ProcedureCall InfernalRobotics::Servo::set_speed_call(flo
   return this->_client->build_call("InfernalRobotics", "Servo_set_Speed", _args);
 }
 
+inline ::krpc::Future<void> InfernalRobotics::Servo::move_center_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("InfernalRobotics", "Servo_MoveCenter", _args));
+}
+
+inline ::krpc::Future<void> InfernalRobotics::Servo::move_left_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("InfernalRobotics", "Servo_MoveLeft", _args));
+}
+
+inline ::krpc::Future<void> InfernalRobotics::Servo::move_next_preset_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("InfernalRobotics", "Servo_MoveNextPreset", _args));
+}
+
+inline ::krpc::Future<void> InfernalRobotics::Servo::move_prev_preset_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("InfernalRobotics", "Servo_MovePrevPreset", _args));
+}
+
+inline ::krpc::Future<void> InfernalRobotics::Servo::move_right_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("InfernalRobotics", "Servo_MoveRight", _args));
+}
+
+inline ::krpc::Future<void> InfernalRobotics::Servo::move_to_async(float position, float speed) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(position));
+  _args.push_back(encoder::encode(speed));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("InfernalRobotics", "Servo_MoveTo", _args));
+}
+
+inline ::krpc::Future<void> InfernalRobotics::Servo::stop_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("InfernalRobotics", "Servo_Stop", _args));
+}
+
+inline ::krpc::Future<float> InfernalRobotics::Servo::acceleration_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<float>(this->_client, this->_client->build_call("InfernalRobotics", "Servo_get_Acceleration", _args), [] (float& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> InfernalRobotics::Servo::set_acceleration_async(float value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("InfernalRobotics", "Servo_set_Acceleration", _args));
+}
+
+inline ::krpc::Future<float> InfernalRobotics::Servo::config_speed_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<float>(this->_client, this->_client->build_call("InfernalRobotics", "Servo_get_ConfigSpeed", _args), [] (float& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<float> InfernalRobotics::Servo::current_speed_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<float>(this->_client, this->_client->build_call("InfernalRobotics", "Servo_get_CurrentSpeed", _args), [] (float& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> InfernalRobotics::Servo::set_current_speed_async(float value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("InfernalRobotics", "Servo_set_CurrentSpeed", _args));
+}
+
+inline ::krpc::Future<void> InfernalRobotics::Servo::set_highlight_async(bool value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("InfernalRobotics", "Servo_set_Highlight", _args));
+}
+
+inline ::krpc::Future<bool> InfernalRobotics::Servo::is_axis_inverted_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<bool>(this->_client, this->_client->build_call("InfernalRobotics", "Servo_get_IsAxisInverted", _args), [] (bool& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> InfernalRobotics::Servo::set_is_axis_inverted_async(bool value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("InfernalRobotics", "Servo_set_IsAxisInverted", _args));
+}
+
+inline ::krpc::Future<bool> InfernalRobotics::Servo::is_free_moving_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<bool>(this->_client, this->_client->build_call("InfernalRobotics", "Servo_get_IsFreeMoving", _args), [] (bool& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<bool> InfernalRobotics::Servo::is_locked_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<bool>(this->_client, this->_client->build_call("InfernalRobotics", "Servo_get_IsLocked", _args), [] (bool& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> InfernalRobotics::Servo::set_is_locked_async(bool value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("InfernalRobotics", "Servo_set_IsLocked", _args));
+}
+
+inline ::krpc::Future<bool> InfernalRobotics::Servo::is_moving_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<bool>(this->_client, this->_client->build_call("InfernalRobotics", "Servo_get_IsMoving", _args), [] (bool& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<float> InfernalRobotics::Servo::max_config_position_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<float>(this->_client, this->_client->build_call("InfernalRobotics", "Servo_get_MaxConfigPosition", _args), [] (float& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<float> InfernalRobotics::Servo::max_position_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<float>(this->_client, this->_client->build_call("InfernalRobotics", "Servo_get_MaxPosition", _args), [] (float& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> InfernalRobotics::Servo::set_max_position_async(float value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("InfernalRobotics", "Servo_set_MaxPosition", _args));
+}
+
+inline ::krpc::Future<float> InfernalRobotics::Servo::min_config_position_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<float>(this->_client, this->_client->build_call("InfernalRobotics", "Servo_get_MinConfigPosition", _args), [] (float& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<float> InfernalRobotics::Servo::min_position_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<float>(this->_client, this->_client->build_call("InfernalRobotics", "Servo_get_MinPosition", _args), [] (float& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> InfernalRobotics::Servo::set_min_position_async(float value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("InfernalRobotics", "Servo_set_MinPosition", _args));
+}
+
+inline ::krpc::Future<std::string> InfernalRobotics::Servo::name_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<std::string>(this->_client, this->_client->build_call("InfernalRobotics", "Servo_get_Name", _args), [] (std::string& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> InfernalRobotics::Servo::set_name_async(std::string value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("InfernalRobotics", "Servo_set_Name", _args));
+}
+
+inline ::krpc::Future<SpaceCenter::Part> InfernalRobotics::Servo::part_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<SpaceCenter::Part>(this->_client, this->_client->build_call("InfernalRobotics", "Servo_get_Part", _args), [] (SpaceCenter::Part& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<float> InfernalRobotics::Servo::position_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<float>(this->_client, this->_client->build_call("InfernalRobotics", "Servo_get_Position", _args), [] (float& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<float> InfernalRobotics::Servo::speed_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<float>(this->_client, this->_client->build_call("InfernalRobotics", "Servo_get_Speed", _args), [] (float& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> InfernalRobotics::Servo::set_speed_async(float value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("InfernalRobotics", "Servo_set_Speed", _args));
+}
+
 inline InfernalRobotics::ServoGroup::ServoGroup(Client* client, uint64_t id):
   Object(client, "InfernalRobotics::ServoGroup", id) {}
 
@@ -1453,6 +1789,126 @@ inline ::krpc::schema::ProcedureCall InfernalRobotics::ServoGroup::set_speed_cal
   _args.push_back(encoder::encode(value));
   return this->_client->build_call("InfernalRobotics", "ServoGroup_set_Speed", _args);
 }
+
+inline ::krpc::Future<void> InfernalRobotics::ServoGroup::move_center_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("InfernalRobotics", "ServoGroup_MoveCenter", _args));
+}
+
+inline ::krpc::Future<void> InfernalRobotics::ServoGroup::move_left_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("InfernalRobotics", "ServoGroup_MoveLeft", _args));
+}
+
+inline ::krpc::Future<void> InfernalRobotics::ServoGroup::move_next_preset_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("InfernalRobotics", "ServoGroup_MoveNextPreset", _args));
+}
+
+inline ::krpc::Future<void> InfernalRobotics::ServoGroup::move_prev_preset_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("InfernalRobotics", "ServoGroup_MovePrevPreset", _args));
+}
+
+inline ::krpc::Future<void> InfernalRobotics::ServoGroup::move_right_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("InfernalRobotics", "ServoGroup_MoveRight", _args));
+}
+
+inline ::krpc::Future<InfernalRobotics::Servo> InfernalRobotics::ServoGroup::servo_with_name_async(std::string name) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(name));
+  return ::krpc::Future<InfernalRobotics::Servo>(this->_client, this->_client->build_call("InfernalRobotics", "ServoGroup_ServoWithName", _args), [] (InfernalRobotics::Servo& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> InfernalRobotics::ServoGroup::stop_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("InfernalRobotics", "ServoGroup_Stop", _args));
+}
+
+inline ::krpc::Future<bool> InfernalRobotics::ServoGroup::expanded_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<bool>(this->_client, this->_client->build_call("InfernalRobotics", "ServoGroup_get_Expanded", _args), [] (bool& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> InfernalRobotics::ServoGroup::set_expanded_async(bool value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("InfernalRobotics", "ServoGroup_set_Expanded", _args));
+}
+
+inline ::krpc::Future<std::string> InfernalRobotics::ServoGroup::forward_key_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<std::string>(this->_client, this->_client->build_call("InfernalRobotics", "ServoGroup_get_ForwardKey", _args), [] (std::string& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> InfernalRobotics::ServoGroup::set_forward_key_async(std::string value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("InfernalRobotics", "ServoGroup_set_ForwardKey", _args));
+}
+
+inline ::krpc::Future<std::string> InfernalRobotics::ServoGroup::name_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<std::string>(this->_client, this->_client->build_call("InfernalRobotics", "ServoGroup_get_Name", _args), [] (std::string& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> InfernalRobotics::ServoGroup::set_name_async(std::string value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("InfernalRobotics", "ServoGroup_set_Name", _args));
+}
+
+inline ::krpc::Future<std::vector<SpaceCenter::Part>> InfernalRobotics::ServoGroup::parts_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<std::vector<SpaceCenter::Part>>(this->_client, this->_client->build_call("InfernalRobotics", "ServoGroup_get_Parts", _args), [] (std::vector<SpaceCenter::Part>& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<std::string> InfernalRobotics::ServoGroup::reverse_key_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<std::string>(this->_client, this->_client->build_call("InfernalRobotics", "ServoGroup_get_ReverseKey", _args), [] (std::string& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> InfernalRobotics::ServoGroup::set_reverse_key_async(std::string value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("InfernalRobotics", "ServoGroup_set_ReverseKey", _args));
+}
+
+inline ::krpc::Future<std::vector<InfernalRobotics::Servo>> InfernalRobotics::ServoGroup::servos_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<std::vector<InfernalRobotics::Servo>>(this->_client, this->_client->build_call("InfernalRobotics", "ServoGroup_get_Servos", _args), [] (std::vector<InfernalRobotics::Servo>& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<float> InfernalRobotics::ServoGroup::speed_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<float>(this->_client, this->_client->build_call("InfernalRobotics", "ServoGroup_get_Speed", _args), [] (float& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> InfernalRobotics::ServoGroup::set_speed_async(float value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("InfernalRobotics", "ServoGroup_set_Speed", _args));
+}
 }  // namespace services
 
 }  // namespace krpc
@@ -10,6 +10,7 @@
 #include <krpc/encoder.hpp>
 #include <krpc/error.hpp>
 #include <krpc/event.hpp>
+#include <krpc/future.hpp>
 #include <krpc/object.hpp>
 #include <krpc/service.hpp>
 #include <krpc/stream.hpp>
@@ -190,6 +191,16 @@ class KerbalAlarmClock : public Service {
 
   ::krpc::schema::ProcedureCall available_call();
 
+  ::krpc::Future<KerbalAlarmClock::Alarm> alarm_with_name_async(std::string name);
+
+  ::krpc::Future<std::vector<KerbalAlarmClock::Alarm>> alarms_with_type_async(KerbalAlarmClock::AlarmType type);
+
+  ::krpc::Future<KerbalAlarmClock::Alarm> create_alarm_async(KerbalAlarmClock::AlarmType type, std::string name, double ut);
+
+  ::krpc::Future<std::vector<KerbalAlarmClock::Alarm>> alarms_async();
+
+  ::krpc::Future<bool> available_async();
+
   /**
    * Represents an alarm. Obtained by calling
    * KerbalAlarmClock::alarms,
@@ -393,6 +404,54 @@ class KerbalAlarmClock : public Service {
     ::krpc::schema::ProcedureCall xfer_target_body_call();
 
     ::krpc::schema::ProcedureCall set_xfer_target_body_call(SpaceCenter::CelestialBody value);
+
+    ::krpc::Future<void> remove_async();
+
+    ::krpc::Future<KerbalAlarmClock::AlarmAction> action_async();
+
+    ::krpc::Future<void> set_action_async(KerbalAlarmClock::AlarmAction value);
+
+    ::krpc::Future<std::string> id_async();
+
+    ::krpc::Future<double> margin_async();
+
+    ::krpc::Future<void> set_margin_async(double value);
+
+    ::krpc::Future<std::string> name_async();
+
+    ::krpc::Future<void> set_name_async(std::string value);
+
+    ::krpc::Future<std::string> notes_async();
+
+    ::krpc::Future<void> set_notes_async(std::string value);
+
+    ::krpc::Future<double> remaining_async();
+
+    ::krpc::Future<bool> repeat_async();
+
+    ::krpc::Future<void> set_repeat_async(bool value);
+
+    ::krpc::Future<double> repeat_period_async();
+
+    ::krpc::Future<void> set_repeat_period_async(double value);
+
+    ::krpc::Future<double> time_async();
+
+    ::krpc::Future<void> set_time_async(double value);
+
+    ::krpc::Future<KerbalAlarmClock::AlarmType> type_async();
+
+    ::krpc::Future<SpaceCenter::Vessel> vessel_async();
+
+    ::krpc::Future<void> set_vessel_async(SpaceCenter::Vessel value);
+
+    ::krpc::Future<SpaceCenter::CelestialBody> xfer_origin_body_async();
+
+    ::krpc::Future<void> set_xfer_origin_body_async(SpaceCenter::CelestialBody value);
+
+    ::krpc::Future<SpaceCenter::CelestialBody> xfer_target_body_async();
+
+    ::krpc::Future<void> set_xfer_target_body_async(SpaceCenter::CelestialBody value);
   };
 };
 
@@ -531,6 +590,34 @@ inline ::krpc::schema::ProcedureCall KerbalAlarmClock::available_call() {
   return this->_client->build_call("KerbalAlarmClock", "get_Available");
 }
 
+inline ::krpc::Future<KerbalAlarmClock::Alarm> KerbalAlarmClock::alarm_with_name_async(std::string name) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(name));
+  return ::krpc::Future<KerbalAlarmClock::Alarm>(this->_client, this->_client->build_call("KerbalAlarmClock", "AlarmWithName", _args), [] (KerbalAlarmClock::Alarm& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<std::vector<KerbalAlarmClock::Alarm>> KerbalAlarmClock::alarms_with_type_async(KerbalAlarmClock::AlarmType type) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(type));
+  return ::krpc::Future<std::vector<KerbalAlarmClock::Alarm>>(this->_client, this->_client->build_call("KerbalAlarmClock", "AlarmsWithType", _args), [] (std::vector<KerbalAlarmClock::Alarm>& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<KerbalAlarmClock::Alarm> KerbalAlarmClock::create_alarm_async(KerbalAlarmClock::AlarmType type, std::string name, double ut) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(type));
+  _args.push_back(encoder::encode(name));
+  _args.push_back(encoder::encode(ut));
+  return ::krpc::Future<KerbalAlarmClock::Alarm>(this->_client, this->_client->build_call("KerbalAlarmClock", "CreateAlarm", _args), [] (KerbalAlarmClock::Alarm& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<std::vector<KerbalAlarmClock::Alarm>> KerbalAlarmClock::alarms_async() {
+  return ::krpc::Future<std::vector<KerbalAlarmClock::Alarm>>(this->_client, this->_client->build_call("KerbalAlarmClock", "get_Alarms"), [] (std::vector<KerbalAlarmClock::Alarm>& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<bool> KerbalAlarmClock::available_async() {
+  return ::krpc::Future<bool>(this->_client, this->_client->build_call("KerbalAlarmClock", "get_Available"), [] (bool& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
 inline KerbalAlarmClock::Alarm::Alarm(Client* client, uint64_t id):
   Object(client, "KerbalAlarmClock::Alarm", id) {}
 
@@ -958,6 +1045,160 @@ inline ::krpc::schema::ProcedureCall KerbalAlarmClock::Alarm::set_xfer_target_bo
   _args.push_back(encoder::encode(value));
   return this->_client->build_call("KerbalAlarmClock", "Alarm_set_XferTargetBody", _args);
 }
+
+inline ::krpc::Future<void> KerbalAlarmClock::Alarm::remove_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("KerbalAlarmClock", "Alarm_Remove", _args));
+}
+
+inline ::krpc::Future<KerbalAlarmClock::AlarmAction> KerbalAlarmClock::Alarm::action_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<KerbalAlarmClock::AlarmAction>(this->_client, this->_client->build_call("KerbalAlarmClock", "Alarm_get_Action", _args), [] (KerbalAlarmClock::AlarmAction& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> KerbalAlarmClock::Alarm::set_action_async(KerbalAlarmClock::AlarmAction value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("KerbalAlarmClock", "Alarm_set_Action", _args));
+}
+
+inline ::krpc::Future<std::string> KerbalAlarmClock::Alarm::id_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<std::string>(this->_client, this->_client->build_call("KerbalAlarmClock", "Alarm_get_ID", _args), [] (std::string& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<double> KerbalAlarmClock::Alarm::margin_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<double>(this->_client, this->_client->build_call("KerbalAlarmClock", "Alarm_get_Margin", _args), [] (double& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> KerbalAlarmClock::Alarm::set_margin_async(double value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("KerbalAlarmClock", "Alarm_set_Margin", _args));
+}
+
+inline ::krpc::Future<std::string> KerbalAlarmClock::Alarm::name_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<std::string>(this->_client, this->_client->build_call("KerbalAlarmClock", "Alarm_get_Name", _args), [] (std::string& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> KerbalAlarmClock::Alarm::set_name_async(std::string value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("KerbalAlarmClock", "Alarm_set_Name", _args));
+}
+
+inline ::krpc::Future<std::string> KerbalAlarmClock::Alarm::notes_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<std::string>(this->_client, this->_client->build_call("KerbalAlarmClock", "Alarm_get_Notes", _args), [] (std::string& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> KerbalAlarmClock::Alarm::set_notes_async(std::string value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("KerbalAlarmClock", "Alarm_set_Notes", _args));
+}
+
+inline ::krpc::Future<double> KerbalAlarmClock::Alarm::remaining_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<double>(this->_client, this->_client->build_call("KerbalAlarmClock", "Alarm_get_Remaining", _args), [] (double& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<bool> KerbalAlarmClock::Alarm::repeat_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<bool>(this->_client, this->_client->build_call("KerbalAlarmClock", "Alarm_get_Repeat", _args), [] (bool& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> KerbalAlarmClock::Alarm::set_repeat_async(bool value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("KerbalAlarmClock", "Alarm_set_Repeat", _args));
+}
+
+inline ::krpc::Future<double> KerbalAlarmClock::Alarm::repeat_period_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<double>(this->_client, this->_client->build_call("KerbalAlarmClock", "Alarm_get_RepeatPeriod", _args), [] (double& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> KerbalAlarmClock::Alarm::set_repeat_period_async(double value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("KerbalAlarmClock", "Alarm_set_RepeatPeriod", _args));
+}
+
+inline ::krpc::Future<double> KerbalAlarmClock::Alarm::time_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<double>(this->_client, this->_client->build_call("KerbalAlarmClock", "Alarm_get_Time", _args), [] (double& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> KerbalAlarmClock::Alarm::set_time_async(double value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("KerbalAlarmClock", "Alarm_set_Time", _args));
+}
+
+inline ::krpc::Future<KerbalAlarmClock::AlarmType> KerbalAlarmClock::Alarm::type_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<KerbalAlarmClock::AlarmType>(this->_client, this->_client->build_call("KerbalAlarmClock", "Alarm_get_Type", _args), [] (KerbalAlarmClock::AlarmType& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<SpaceCenter::Vessel> KerbalAlarmClock::Alarm::vessel_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<SpaceCenter::Vessel>(this->_client, this->_client->build_call("KerbalAlarmClock", "Alarm_get_Vessel", _args), [] (SpaceCenter::Vessel& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> KerbalAlarmClock::Alarm::set_vessel_async(SpaceCenter::Vessel value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("KerbalAlarmClock", "Alarm_set_Vessel", _args));
+}
+
+inline ::krpc::Future<SpaceCenter::CelestialBody> KerbalAlarmClock::Alarm::xfer_origin_body_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<SpaceCenter::CelestialBody>(this->_client, this->_client->build_call("KerbalAlarmClock", "Alarm_get_XferOriginBody", _args), [] (SpaceCenter::CelestialBody& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> KerbalAlarmClock::Alarm::set_xfer_origin_body_async(SpaceCenter::CelestialBody value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("KerbalAlarmClock", "Alarm_set_XferOriginBody", _args));
+}
+
+inline ::krpc::Future<SpaceCenter::CelestialBody> KerbalAlarmClock::Alarm::xfer_target_body_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<SpaceCenter::CelestialBody>(this->_client, this->_client->build_call("KerbalAlarmClock", "Alarm_get_XferTargetBody", _args), [] (SpaceCenter::CelestialBody& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> KerbalAlarmClock::Alarm::set_xfer_target_body_async(SpaceCenter::CelestialBody value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("KerbalAlarmClock", "Alarm_set_XferTargetBody", _args));
+}
 }  // namespace services
 
 }  // namespace krpc
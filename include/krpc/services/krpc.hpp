@@ -10,6 +10,7 @@
 #include <krpc/encoder.hpp>
 #include <krpc/error.hpp>
 #include <krpc/event.hpp>
+#include <krpc/future.hpp>
 #include <krpc/object.hpp>
 #include <krpc/service.hpp>
 #include <krpc/stream.hpp>
@@ -197,6 +198,32 @@ class KRPC : public Service {
 
   ::krpc::schema::ProcedureCall set_paused_call(bool value);
 
+  ::krpc::Future<::krpc::Event> add_event_async(KRPC::Expression expression);
+
+  ::krpc::Future<krpc::schema::Stream> add_stream_async(krpc::schema::ProcedureCall call, bool start);
+
+  ::krpc::Future<std::string> get_client_id_async();
+
+  ::krpc::Future<std::string> get_client_name_async();
+
+  ::krpc::Future<krpc::schema::Services> get_services_async();
+
+  ::krpc::Future<krpc::schema::Status> get_status_async();
+
+  ::krpc::Future<void> remove_stream_async(uint64_t id);
+
+  ::krpc::Future<void> set_stream_rate_async(uint64_t id, float rate);
+
+  ::krpc::Future<void> start_stream_async(uint64_t id);
+
+  ::krpc::Future<std::vector<std::tuple<std::string, std::string, std::string> >> clients_async();
+
+  ::krpc::Future<KRPC::GameScene> current_game_scene_async();
+
+  ::krpc::Future<bool> paused_async();
+
+  ::krpc::Future<void> set_paused_async(bool value);
+
   /**
    * A server side expression.
    */
@@ -753,6 +780,104 @@ class KRPC : public Service {
     static ::krpc::schema::ProcedureCall to_set_call(Client& client, KRPC::Expression arg);
 
     static ::krpc::schema::ProcedureCall where_call(Client& client, KRPC::Expression arg, KRPC::Expression func);
+
+    static ::krpc::Future<KRPC::Expression> add_async(Client& client, KRPC::Expression arg0, KRPC::Expression arg1);
+
+    static ::krpc::Future<KRPC::Expression> aggregate_async(Client& client, KRPC::Expression arg, KRPC::Expression func);
+
+    static ::krpc::Future<KRPC::Expression> aggregate_with_seed_async(Client& client, KRPC::Expression arg, KRPC::Expression seed, KRPC::Expression func);
+
+    static ::krpc::Future<KRPC::Expression> all_async(Client& client, KRPC::Expression arg, KRPC::Expression predicate);
+
+    static ::krpc::Future<KRPC::Expression> and__async(Client& client, KRPC::Expression arg0, KRPC::Expression arg1);
+
+    static ::krpc::Future<KRPC::Expression> any_async(Client& client, KRPC::Expression arg, KRPC::Expression predicate);
+
+    static ::krpc::Future<KRPC::Expression> average_async(Client& client, KRPC::Expression arg);
+
+    static ::krpc::Future<KRPC::Expression> call_async(Client& client, krpc::schema::ProcedureCall call);
+
+    static ::krpc::Future<KRPC::Expression> cast_async(Client& client, KRPC::Expression arg, KRPC::Type type);
+
+    static ::krpc::Future<KRPC::Expression> concat_async(Client& client, KRPC::Expression arg1, KRPC::Expression arg2);
+
+    static ::krpc::Future<KRPC::Expression> constant_bool_async(Client& client, bool value);
+
+    static ::krpc::Future<KRPC::Expression> constant_double_async(Client& client, double value);
+
+    static ::krpc::Future<KRPC::Expression> constant_float_async(Client& client, float value);
+
+    static ::krpc::Future<KRPC::Expression> constant_int_async(Client& client, int32_t value);
+
+    static ::krpc::Future<KRPC::Expression> constant_string_async(Client& client, std::string value);
+
+    static ::krpc::Future<KRPC::Expression> contains_async(Client& client, KRPC::Expression arg, KRPC::Expression value);
+
+    static ::krpc::Future<KRPC::Expression> count_async(Client& client, KRPC::Expression arg);
+
+    static ::krpc::Future<KRPC::Expression> create_dictionary_async(Client& client, std::vector<KRPC::Expression> keys, std::vector<KRPC::Expression> values);
+
+    static ::krpc::Future<KRPC::Expression> create_list_async(Client& client, std::vector<KRPC::Expression> values);
+
+    static ::krpc::Future<KRPC::Expression> create_set_async(Client& client, std::set<KRPC::Expression> values);
+
+    static ::krpc::Future<KRPC::Expression> create_tuple_async(Client& client, std::vector<KRPC::Expression> elements);
+
+    static ::krpc::Future<KRPC::Expression> divide_async(Client& client, KRPC::Expression arg0, KRPC::Expression arg1);
+
+    static ::krpc::Future<KRPC::Expression> equal_async(Client& client, KRPC::Expression arg0, KRPC::Expression arg1);
+
+    static ::krpc::Future<KRPC::Expression> exclusive_or_async(Client& client, KRPC::Expression arg0, KRPC::Expression arg1);
+
+    static ::krpc::Future<KRPC::Expression> function_async(Client& client, std::vector<KRPC::Expression> parameters, KRPC::Expression body);
+
+    static ::krpc::Future<KRPC::Expression> get_async(Client& client, KRPC::Expression arg, KRPC::Expression index);
+
+    static ::krpc::Future<KRPC::Expression> greater_than_async(Client& client, KRPC::Expression arg0, KRPC::Expression arg1);
+
+    static ::krpc::Future<KRPC::Expression> greater_than_or_equal_async(Client& client, KRPC::Expression arg0, KRPC::Expression arg1);
+
+    static ::krpc::Future<KRPC::Expression> invoke_async(Client& client, KRPC::Expression function, std::map<std::string, KRPC::Expression> args);
+
+    static ::krpc::Future<KRPC::Expression> left_shift_async(Client& client, KRPC::Expression arg0, KRPC::Expression arg1);
+
+    static ::krpc::Future<KRPC::Expression> less_than_async(Client& client, KRPC::Expression arg0, KRPC::Expression arg1);
+
+    static ::krpc::Future<KRPC::Expression> less_than_or_equal_async(Client& client, KRPC::Expression arg0, KRPC::Expression arg1);
+
+    static ::krpc::Future<KRPC::Expression> max_async(Client& client, KRPC::Expression arg);
+
+    static ::krpc::Future<KRPC::Expression> min_async(Client& client, KRPC::Expression arg);
+
+    static ::krpc::Future<KRPC::Expression> modulo_async(Client& client, KRPC::Expression arg0, KRPC::Expression arg1);
+
+    static ::krpc::Future<KRPC::Expression> multiply_async(Client& client, KRPC::Expression arg0, KRPC::Expression arg1);
+
+    static ::krpc::Future<KRPC::Expression> not__async(Client& client, KRPC::Expression arg);
+
+    static ::krpc::Future<KRPC::Expression> not_equal_async(Client& client, KRPC::Expression arg0, KRPC::Expression arg1);
+
+    static ::krpc::Future<KRPC::Expression> or__async(Client& client, KRPC::Expression arg0, KRPC::Expression arg1);
+
+    static ::krpc::Future<KRPC::Expression> order_by_async(Client& client, KRPC::Expression arg, KRPC::Expression key);
+
+    static ::krpc::Future<KRPC::Expression> parameter_async(Client& client, std::string name, KRPC::Type type);
+
+    static ::krpc::Future<KRPC::Expression> power_async(Client& client, KRPC::Expression arg0, KRPC::Expression arg1);
+
+    static ::krpc::Future<KRPC::Expression> right_shift_async(Client& client, KRPC::Expression arg0, KRPC::Expression arg1);
+
+    static ::krpc::Future<KRPC::Expression> select_async(Client& client, KRPC::Expression arg, KRPC::Expression func);
+
+    static ::krpc::Future<KRPC::Expression> subtract_async(Client& client, KRPC::Expression arg0, KRPC::Expression arg1);
+
+    static ::krpc::Future<KRPC::Expression> sum_async(Client& client, KRPC::Expression arg);
+
+    static ::krpc::Future<KRPC::Expression> to_list_async(Client& client, KRPC::Expression arg);
+
+    static ::krpc::Future<KRPC::Expression> to_set_async(Client& client, KRPC::Expression arg);
+
+    static ::krpc::Future<KRPC::Expression> where_async(Client& client, KRPC::Expression arg, KRPC::Expression func);
   };
 
   /**
@@ -806,6 +931,16 @@ class KRPC : public Service {
     static ::krpc::schema::ProcedureCall int__call(Client& client);
 
     static ::krpc::schema::ProcedureCall string_call(Client& client);
+
+    static ::krpc::Future<KRPC::Type> bool__async(Client& client);
+
+    static ::krpc::Future<KRPC::Type> double__async(Client& client);
+
+    static ::krpc::Future<KRPC::Type> float__async(Client& client);
+
+    static ::krpc::Future<KRPC::Type> int__async(Client& client);
+
+    static ::krpc::Future<KRPC::Type> string_async(Client& client);
   };
 };
 
@@ -1047,6 +1182,72 @@ inline ::krpc::schema::ProcedureCall KRPC::set_paused_call(bool value) {
   return this->_client->build_call("KRPC", "set_Paused", _args);
 }
 
+inline ::krpc::Future<::krpc::Event> KRPC::add_event_async(KRPC::Expression expression) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(expression));
+  return ::krpc::Future<::krpc::Event>(this->_client, this->_client->build_call("KRPC", "AddEvent", _args), [] (::krpc::Event& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<krpc::schema::Stream> KRPC::add_stream_async(krpc::schema::ProcedureCall call, bool start = true) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(call));
+  _args.push_back(encoder::encode(start));
+  return ::krpc::Future<krpc::schema::Stream>(this->_client, this->_client->build_call("KRPC", "AddStream", _args), [] (krpc::schema::Stream& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<std::string> KRPC::get_client_id_async() {
+  return ::krpc::Future<std::string>(this->_client, this->_client->build_call("KRPC", "GetClientID"), [] (std::string& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<std::string> KRPC::get_client_name_async() {
+  return ::krpc::Future<std::string>(this->_client, this->_client->build_call("KRPC", "GetClientName"), [] (std::string& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<krpc::schema::Services> KRPC::get_services_async() {
+  return ::krpc::Future<krpc::schema::Services>(this->_client, this->_client->build_call("KRPC", "GetServices"), [] (krpc::schema::Services& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<krpc::schema::Status> KRPC::get_status_async() {
+  return ::krpc::Future<krpc::schema::Status>(this->_client, this->_client->build_call("KRPC", "GetStatus"), [] (krpc::schema::Status& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> KRPC::remove_stream_async(uint64_t id) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(id));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("KRPC", "RemoveStream", _args));
+}
+
+inline ::krpc::Future<void> KRPC::set_stream_rate_async(uint64_t id, float rate) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(id));
+  _args.push_back(encoder::encode(rate));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("KRPC", "SetStreamRate", _args));
+}
+
+inline ::krpc::Future<void> KRPC::start_stream_async(uint64_t id) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(id));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("KRPC", "StartStream", _args));
+}
+
+inline ::krpc::Future<std::vector<std::tuple<std::string, std::string, std::string> >> KRPC::clients_async() {
+  return ::krpc::Future<std::vector<std::tuple<std::string, std::string, std::string> >>(this->_client, this->_client->build_call("KRPC", "get_Clients"), [] (std::vector<std::tuple<std::string, std::string, std::string> >& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<KRPC::GameScene> KRPC::current_game_scene_async() {
+  return ::krpc::Future<KRPC::GameScene>(this->_client, this->_client->build_call("KRPC", "get_CurrentGameScene"), [] (KRPC::GameScene& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<bool> KRPC::paused_async() {
+  return ::krpc::Future<bool>(this->_client, this->_client->build_call("KRPC", "get_Paused"), [] (bool& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> KRPC::set_paused_async(bool value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("KRPC", "set_Paused", _args));
+}
+
 inline KRPC::Expression::Expression(Client* client, uint64_t id):
   Object(client, "KRPC::Expression", id) {}
 
@@ -2178,6 +2379,333 @@ inline ::krpc::schema::ProcedureCall KRPC::Expression::where_call(Client& _clien
   return _client.build_call("KRPC", "Expression_static_Where", _args);
 }
 
+inline ::krpc::Future<KRPC::Expression> KRPC::Expression::add_async(Client& _client, KRPC::Expression arg0, KRPC::Expression arg1) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(arg0));
+  _args.push_back(encoder::encode(arg1));
+  return ::krpc::Future<KRPC::Expression>(&_client, _client.build_call("KRPC", "Expression_static_Add", _args), [] (KRPC::Expression& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<KRPC::Expression> KRPC::Expression::aggregate_async(Client& _client, KRPC::Expression arg, KRPC::Expression func) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(arg));
+  _args.push_back(encoder::encode(func));
+  return ::krpc::Future<KRPC::Expression>(&_client, _client.build_call("KRPC", "Expression_static_Aggregate", _args), [] (KRPC::Expression& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<KRPC::Expression> KRPC::Expression::aggregate_with_seed_async(Client& _client, KRPC::Expression arg, KRPC::Expression seed, KRPC::Expression func) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(arg));
+  _args.push_back(encoder::encode(seed));
+  _args.push_back(encoder::encode(func));
+  return ::krpc::Future<KRPC::Expression>(&_client, _client.build_call("KRPC", "Expression_static_AggregateWithSeed", _args), [] (KRPC::Expression& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<KRPC::Expression> KRPC::Expression::all_async(Client& _client, KRPC::Expression arg, KRPC::Expression predicate) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(arg));
+  _args.push_back(encoder::encode(predicate));
+  return ::krpc::Future<KRPC::Expression>(&_client, _client.build_call("KRPC", "Expression_static_All", _args), [] (KRPC::Expression& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<KRPC::Expression> KRPC::Expression::and__async(Client& _client, KRPC::Expression arg0, KRPC::Expression arg1) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(arg0));
+  _args.push_back(encoder::encode(arg1));
+  return ::krpc::Future<KRPC::Expression>(&_client, _client.build_call("KRPC", "Expression_static_And", _args), [] (KRPC::Expression& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<KRPC::Expression> KRPC::Expression::any_async(Client& _client, KRPC::Expression arg, KRPC::Expression predicate) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(arg));
+  _args.push_back(encoder::encode(predicate));
+  return ::krpc::Future<KRPC::Expression>(&_client, _client.build_call("KRPC", "Expression_static_Any", _args), [] (KRPC::Expression& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<KRPC::Expression> KRPC::Expression::average_async(Client& _client, KRPC::Expression arg) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(arg));
+  return ::krpc::Future<KRPC::Expression>(&_client, _client.build_call("KRPC", "Expression_static_Average", _args), [] (KRPC::Expression& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<KRPC::Expression> KRPC::Expression::call_async(Client& _client, krpc::schema::ProcedureCall call) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(call));
+  return ::krpc::Future<KRPC::Expression>(&_client, _client.build_call("KRPC", "Expression_static_Call", _args), [] (KRPC::Expression& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<KRPC::Expression> KRPC::Expression::cast_async(Client& _client, KRPC::Expression arg, KRPC::Type type) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(arg));
+  _args.push_back(encoder::encode(type));
+  return ::krpc::Future<KRPC::Expression>(&_client, _client.build_call("KRPC", "Expression_static_Cast", _args), [] (KRPC::Expression& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<KRPC::Expression> KRPC::Expression::concat_async(Client& _client, KRPC::Expression arg1, KRPC::Expression arg2) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(arg1));
+  _args.push_back(encoder::encode(arg2));
+  return ::krpc::Future<KRPC::Expression>(&_client, _client.build_call("KRPC", "Expression_static_Concat", _args), [] (KRPC::Expression& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<KRPC::Expression> KRPC::Expression::constant_bool_async(Client& _client, bool value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<KRPC::Expression>(&_client, _client.build_call("KRPC", "Expression_static_ConstantBool", _args), [] (KRPC::Expression& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<KRPC::Expression> KRPC::Expression::constant_double_async(Client& _client, double value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<KRPC::Expression>(&_client, _client.build_call("KRPC", "Expression_static_ConstantDouble", _args), [] (KRPC::Expression& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<KRPC::Expression> KRPC::Expression::constant_float_async(Client& _client, float value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<KRPC::Expression>(&_client, _client.build_call("KRPC", "Expression_static_ConstantFloat", _args), [] (KRPC::Expression& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<KRPC::Expression> KRPC::Expression::constant_int_async(Client& _client, int32_t value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<KRPC::Expression>(&_client, _client.build_call("KRPC", "Expression_static_ConstantInt", _args), [] (KRPC::Expression& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<KRPC::Expression> KRPC::Expression::constant_string_async(Client& _client, std::string value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<KRPC::Expression>(&_client, _client.build_call("KRPC", "Expression_static_ConstantString", _args), [] (KRPC::Expression& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<KRPC::Expression> KRPC::Expression::contains_async(Client& _client, KRPC::Expression arg, KRPC::Expression value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(arg));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<KRPC::Expression>(&_client, _client.build_call("KRPC", "Expression_static_Contains", _args), [] (KRPC::Expression& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<KRPC::Expression> KRPC::Expression::count_async(Client& _client, KRPC::Expression arg) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(arg));
+  return ::krpc::Future<KRPC::Expression>(&_client, _client.build_call("KRPC", "Expression_static_Count", _args), [] (KRPC::Expression& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<KRPC::Expression> KRPC::Expression::create_dictionary_async(Client& _client, std::vector<KRPC::Expression> keys, std::vector<KRPC::Expression> values) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(keys));
+  _args.push_back(encoder::encode(values));
+  return ::krpc::Future<KRPC::Expression>(&_client, _client.build_call("KRPC", "Expression_static_CreateDictionary", _args), [] (KRPC::Expression& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<KRPC::Expression> KRPC::Expression::create_list_async(Client& _client, std::vector<KRPC::Expression> values) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(values));
+  return ::krpc::Future<KRPC::Expression>(&_client, _client.build_call("KRPC", "Expression_static_CreateList", _args), [] (KRPC::Expression& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<KRPC::Expression> KRPC::Expression::create_set_async(Client& _client, std::set<KRPC::Expression> values) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(values));
+  return ::krpc::Future<KRPC::Expression>(&_client, _client.build_call("KRPC", "Expression_static_CreateSet", _args), [] (KRPC::Expression& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<KRPC::Expression> KRPC::Expression::create_tuple_async(Client& _client, std::vector<KRPC::Expression> elements) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(elements));
+  return ::krpc::Future<KRPC::Expression>(&_client, _client.build_call("KRPC", "Expression_static_CreateTuple", _args), [] (KRPC::Expression& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<KRPC::Expression> KRPC::Expression::divide_async(Client& _client, KRPC::Expression arg0, KRPC::Expression arg1) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(arg0));
+  _args.push_back(encoder::encode(arg1));
+  return ::krpc::Future<KRPC::Expression>(&_client, _client.build_call("KRPC", "Expression_static_Divide", _args), [] (KRPC::Expression& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<KRPC::Expression> KRPC::Expression::equal_async(Client& _client, KRPC::Expression arg0, KRPC::Expression arg1) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(arg0));
+  _args.push_back(encoder::encode(arg1));
+  return ::krpc::Future<KRPC::Expression>(&_client, _client.build_call("KRPC", "Expression_static_Equal", _args), [] (KRPC::Expression& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<KRPC::Expression> KRPC::Expression::exclusive_or_async(Client& _client, KRPC::Expression arg0, KRPC::Expression arg1) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(arg0));
+  _args.push_back(encoder::encode(arg1));
+  return ::krpc::Future<KRPC::Expression>(&_client, _client.build_call("KRPC", "Expression_static_ExclusiveOr", _args), [] (KRPC::Expression& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<KRPC::Expression> KRPC::Expression::function_async(Client& _client, std::vector<KRPC::Expression> parameters, KRPC::Expression body) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(parameters));
+  _args.push_back(encoder::encode(body));
+  return ::krpc::Future<KRPC::Expression>(&_client, _client.build_call("KRPC", "Expression_static_Function", _args), [] (KRPC::Expression& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<KRPC::Expression> KRPC::Expression::get_async(Client& _client, KRPC::Expression arg, KRPC::Expression index) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(arg));
+  _args.push_back(encoder::encode(index));
+  return ::krpc::Future<KRPC::Expression>(&_client, _client.build_call("KRPC", "Expression_static_Get", _args), [] (KRPC::Expression& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<KRPC::Expression> KRPC::Expression::greater_than_async(Client& _client, KRPC::Expression arg0, KRPC::Expression arg1) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(arg0));
+  _args.push_back(encoder::encode(arg1));
+  return ::krpc::Future<KRPC::Expression>(&_client, _client.build_call("KRPC", "Expression_static_GreaterThan", _args), [] (KRPC::Expression& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<KRPC::Expression> KRPC::Expression::greater_than_or_equal_async(Client& _client, KRPC::Expression arg0, KRPC::Expression arg1) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(arg0));
+  _args.push_back(encoder::encode(arg1));
+  return ::krpc::Future<KRPC::Expression>(&_client, _client.build_call("KRPC", "Expression_static_GreaterThanOrEqual", _args), [] (KRPC::Expression& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<KRPC::Expression> KRPC::Expression::invoke_async(Client& _client, KRPC::Expression function, std::map<std::string, KRPC::Expression> args) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(function));
+  _args.push_back(encoder::encode(args));
+  return ::krpc::Future<KRPC::Expression>(&_client, _client.build_call("KRPC", "Expression_static_Invoke", _args), [] (KRPC::Expression& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<KRPC::Expression> KRPC::Expression::left_shift_async(Client& _client, KRPC::Expression arg0, KRPC::Expression arg1) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(arg0));
+  _args.push_back(encoder::encode(arg1));
+  return ::krpc::Future<KRPC::Expression>(&_client, _client.build_call("KRPC", "Expression_static_LeftShift", _args), [] (KRPC::Expression& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<KRPC::Expression> KRPC::Expression::less_than_async(Client& _client, KRPC::Expression arg0, KRPC::Expression arg1) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(arg0));
+  _args.push_back(encoder::encode(arg1));
+  return ::krpc::Future<KRPC::Expression>(&_client, _client.build_call("KRPC", "Expression_static_LessThan", _args), [] (KRPC::Expression& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<KRPC::Expression> KRPC::Expression::less_than_or_equal_async(Client& _client, KRPC::Expression arg0, KRPC::Expression arg1) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(arg0));
+  _args.push_back(encoder::encode(arg1));
+  return ::krpc::Future<KRPC::Expression>(&_client, _client.build_call("KRPC", "Expression_static_LessThanOrEqual", _args), [] (KRPC::Expression& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<KRPC::Expression> KRPC::Expression::max_async(Client& _client, KRPC::Expression arg) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(arg));
+  return ::krpc::Future<KRPC::Expression>(&_client, _client.build_call("KRPC", "Expression_static_Max", _args), [] (KRPC::Expression& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<KRPC::Expression> KRPC::Expression::min_async(Client& _client, KRPC::Expression arg) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(arg));
+  return ::krpc::Future<KRPC::Expression>(&_client, _client.build_call("KRPC", "Expression_static_Min", _args), [] (KRPC::Expression& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<KRPC::Expression> KRPC::Expression::modulo_async(Client& _client, KRPC::Expression arg0, KRPC::Expression arg1) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(arg0));
+  _args.push_back(encoder::encode(arg1));
+  return ::krpc::Future<KRPC::Expression>(&_client, _client.build_call("KRPC", "Expression_static_Modulo", _args), [] (KRPC::Expression& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<KRPC::Expression> KRPC::Expression::multiply_async(Client& _client, KRPC::Expression arg0, KRPC::Expression arg1) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(arg0));
+  _args.push_back(encoder::encode(arg1));
+  return ::krpc::Future<KRPC::Expression>(&_client, _client.build_call("KRPC", "Expression_static_Multiply", _args), [] (KRPC::Expression& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<KRPC::Expression> KRPC::Expression::not__async(Client& _client, KRPC::Expression arg) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(arg));
+  return ::krpc::Future<KRPC::Expression>(&_client, _client.build_call("KRPC", "Expression_static_Not", _args), [] (KRPC::Expression& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<KRPC::Expression> KRPC::Expression::not_equal_async(Client& _client, KRPC::Expression arg0, KRPC::Expression arg1) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(arg0));
+  _args.push_back(encoder::encode(arg1));
+  return ::krpc::Future<KRPC::Expression>(&_client, _client.build_call("KRPC", "Expression_static_NotEqual", _args), [] (KRPC::Expression& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<KRPC::Expression> KRPC::Expression::or__async(Client& _client, KRPC::Expression arg0, KRPC::Expression arg1) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(arg0));
+  _args.push_back(encoder::encode(arg1));
+  return ::krpc::Future<KRPC::Expression>(&_client, _client.build_call("KRPC", "Expression_static_Or", _args), [] (KRPC::Expression& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<KRPC::Expression> KRPC::Expression::order_by_async(Client& _client, KRPC::Expression arg, KRPC::Expression key) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(arg));
+  _args.push_back(encoder::encode(key));
+  return ::krpc::Future<KRPC::Expression>(&_client, _client.build_call("KRPC", "Expression_static_OrderBy", _args), [] (KRPC::Expression& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<KRPC::Expression> KRPC::Expression::parameter_async(Client& _client, std::string name, KRPC::Type type) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(name));
+  _args.push_back(encoder::encode(type));
+  return ::krpc::Future<KRPC::Expression>(&_client, _client.build_call("KRPC", "Expression_static_Parameter", _args), [] (KRPC::Expression& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<KRPC::Expression> KRPC::Expression::power_async(Client& _client, KRPC::Expression arg0, KRPC::Expression arg1) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(arg0));
+  _args.push_back(encoder::encode(arg1));
+  return ::krpc::Future<KRPC::Expression>(&_client, _client.build_call("KRPC", "Expression_static_Power", _args), [] (KRPC::Expression& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<KRPC::Expression> KRPC::Expression::right_shift_async(Client& _client, KRPC::Expression arg0, KRPC::Expression arg1) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(arg0));
+  _args.push_back(encoder::encode(arg1));
+  return ::krpc::Future<KRPC::Expression>(&_client, _client.build_call("KRPC", "Expression_static_RightShift", _args), [] (KRPC::Expression& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<KRPC::Expression> KRPC::Expression::select_async(Client& _client, KRPC::Expression arg, KRPC::Expression func) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(arg));
+  _args.push_back(encoder::encode(func));
+  return ::krpc::Future<KRPC::Expression>(&_client, _client.build_call("KRPC", "Expression_static_Select", _args), [] (KRPC::Expression& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<KRPC::Expression> KRPC::Expression::subtract_async(Client& _client, KRPC::Expression arg0, KRPC::Expression arg1) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(arg0));
+  _args.push_back(encoder::encode(arg1));
+  return ::krpc::Future<KRPC::Expression>(&_client, _client.build_call("KRPC", "Expression_static_Subtract", _args), [] (KRPC::Expression& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<KRPC::Expression> KRPC::Expression::sum_async(Client& _client, KRPC::Expression arg) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(arg));
+  return ::krpc::Future<KRPC::Expression>(&_client, _client.build_call("KRPC", "Expression_static_Sum", _args), [] (KRPC::Expression& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<KRPC::Expression> KRPC::Expression::to_list_async(Client& _client, KRPC::Expression arg) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(arg));
+  return ::krpc::Future<KRPC::Expression>(&_client, _client.build_call("KRPC", "Expression_static_ToList", _args), [] (KRPC::Expression& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<KRPC::Expression> KRPC::Expression::to_set_async(Client& _client, KRPC::Expression arg) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(arg));
+  return ::krpc::Future<KRPC::Expression>(&_client, _client.build_call("KRPC", "Expression_static_ToSet", _args), [] (KRPC::Expression& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<KRPC::Expression> KRPC::Expression::where_async(Client& _client, KRPC::Expression arg, KRPC::Expression func) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(arg));
+  _args.push_back(encoder::encode(func));
+  return ::krpc::Future<KRPC::Expression>(&_client, _client.build_call("KRPC", "Expression_static_Where", _args), [] (KRPC::Expression& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
 inline KRPC::Type::Type(Client* client, uint64_t id):
   Object(client, "KRPC::Type", id) {}
 
@@ -2255,6 +2783,26 @@ inline ::krpc::schema::ProcedureCall KRPC::Type::int__call(Client& _client) {
 inline ::krpc::schema::ProcedureCall KRPC::Type::string_call(Client& _client) {
   return _client.build_call("KRPC", "Type_static_String");
 }
+
+inline ::krpc::Future<KRPC::Type> KRPC::Type::bool__async(Client& _client) {
+  return ::krpc::Future<KRPC::Type>(&_client, _client.build_call("KRPC", "Type_static_Bool"), [] (KRPC::Type& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<KRPC::Type> KRPC::Type::double__async(Client& _client) {
+  return ::krpc::Future<KRPC::Type>(&_client, _client.build_call("KRPC", "Type_static_Double"), [] (KRPC::Type& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<KRPC::Type> KRPC::Type::float__async(Client& _client) {
+  return ::krpc::Future<KRPC::Type>(&_client, _client.build_call("KRPC", "Type_static_Float"), [] (KRPC::Type& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<KRPC::Type> KRPC::Type::int__async(Client& _client) {
+  return ::krpc::Future<KRPC::Type>(&_client, _client.build_call("KRPC", "Type_static_Int"), [] (KRPC::Type& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<KRPC::Type> KRPC::Type::string_async(Client& _client) {
+  return ::krpc::Future<KRPC::Type>(&_client, _client.build_call("KRPC", "Type_static_String"), [] (KRPC::Type& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
 }  // namespace services
 
 }  // namespace krpc
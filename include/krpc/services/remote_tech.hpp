@@ -10,6 +10,7 @@
 #include <krpc/encoder.hpp>
 #include <krpc/error.hpp>
 #include <krpc/event.hpp>
+#include <krpc/future.hpp>
 #include <krpc/object.hpp>
 #include <krpc/service.hpp>
 #include <krpc/stream.hpp>
@@ -88,6 +89,14 @@ class RemoteTech : public Service {
 
   ::krpc::schema::ProcedureCall ground_stations_call();
 
+  ::krpc::Future<RemoteTech::Antenna> antenna_async(SpaceCenter::Part part);
+
+  ::krpc::Future<RemoteTech::Comms> comms_async(SpaceCenter::Vessel vessel);
+
+  ::krpc::Future<bool> available_async();
+
+  ::krpc::Future<std::vector<std::string>> ground_stations_async();
+
   /**
    * A RemoteTech antenna. Obtained by calling RemoteTech::Comms::antennas or RemoteTech::antenna.
    */
@@ -182,6 +191,26 @@ class RemoteTech : public Service {
     ::krpc::schema::ProcedureCall target_vessel_call();
 
     ::krpc::schema::ProcedureCall set_target_vessel_call(SpaceCenter::Vessel value);
+
+    ::krpc::Future<bool> has_connection_async();
+
+    ::krpc::Future<SpaceCenter::Part> part_async();
+
+    ::krpc::Future<RemoteTech::Target> target_async();
+
+    ::krpc::Future<void> set_target_async(RemoteTech::Target value);
+
+    ::krpc::Future<SpaceCenter::CelestialBody> target_body_async();
+
+    ::krpc::Future<void> set_target_body_async(SpaceCenter::CelestialBody value);
+
+    ::krpc::Future<std::string> target_ground_station_async();
+
+    ::krpc::Future<void> set_target_ground_station_async(std::string value);
+
+    ::krpc::Future<SpaceCenter::Vessel> target_vessel_async();
+
+    ::krpc::Future<void> set_target_vessel_async(SpaceCenter::Vessel value);
   };
 
   /**
@@ -272,6 +301,24 @@ class RemoteTech : public Service {
     ::krpc::schema::ProcedureCall signal_delay_to_ground_station_call();
 
     ::krpc::schema::ProcedureCall vessel_call();
+
+    ::krpc::Future<double> signal_delay_to_vessel_async(SpaceCenter::Vessel other);
+
+    ::krpc::Future<std::vector<RemoteTech::Antenna>> antennas_async();
+
+    ::krpc::Future<bool> has_connection_async();
+
+    ::krpc::Future<bool> has_connection_to_ground_station_async();
+
+    ::krpc::Future<bool> has_flight_computer_async();
+
+    ::krpc::Future<bool> has_local_control_async();
+
+    ::krpc::Future<double> signal_delay_async();
+
+    ::krpc::Future<double> signal_delay_to_ground_station_async();
+
+    ::krpc::Future<SpaceCenter::Vessel> vessel_async();
   };
 };
 
@@ -373,6 +420,26 @@ inline ::krpc::schema::ProcedureCall RemoteTech::ground_stations_call() {
   return this->_client->build_call("RemoteTech", "get_GroundStations");
 }
 
+inline ::krpc::Future<RemoteTech::Antenna> RemoteTech::antenna_async(SpaceCenter::Part part) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(part));
+  return ::krpc::Future<RemoteTech::Antenna>(this->_client, this->_client->build_call("RemoteTech", "Antenna", _args), [] (RemoteTech::Antenna& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<RemoteTech::Comms> RemoteTech::comms_async(SpaceCenter::Vessel vessel) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(vessel));
+  return ::krpc::Future<RemoteTech::Comms>(this->_client, this->_client->build_call("RemoteTech", "Comms", _args), [] (RemoteTech::Comms& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<bool> RemoteTech::available_async() {
+  return ::krpc::Future<bool>(this->_client, this->_client->build_call("RemoteTech", "get_Available"), [] (bool& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<std::vector<std::string>> RemoteTech::ground_stations_async() {
+  return ::krpc::Future<std::vector<std::string>>(this->_client, this->_client->build_call("RemoteTech", "get_GroundStations"), [] (std::vector<std::string>& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
 inline RemoteTech::Antenna::Antenna(Client* client, uint64_t id):
   Object(client, "RemoteTech::Antenna", id) {}
 
@@ -558,6 +625,70 @@ inline ::krpc::schema::ProcedureCall RemoteTech::Antenna::set_target_vessel_call
   return this->_client->build_call("RemoteTech", "Antenna_set_TargetVessel", _args);
 }
 
+inline ::krpc::Future<bool> RemoteTech::Antenna::has_connection_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<bool>(this->_client, this->_client->build_call("RemoteTech", "Antenna_get_HasConnection", _args), [] (bool& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<SpaceCenter::Part> RemoteTech::Antenna::part_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<SpaceCenter::Part>(this->_client, this->_client->build_call("RemoteTech", "Antenna_get_Part", _args), [] (SpaceCenter::Part& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<RemoteTech::Target> RemoteTech::Antenna::target_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<RemoteTech::Target>(this->_client, this->_client->build_call("RemoteTech", "Antenna_get_Target", _args), [] (RemoteTech::Target& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> RemoteTech::Antenna::set_target_async(RemoteTech::Target value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("RemoteTech", "Antenna_set_Target", _args));
+}
+
+inline ::krpc::Future<SpaceCenter::CelestialBody> RemoteTech::Antenna::target_body_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<SpaceCenter::CelestialBody>(this->_client, this->_client->build_call("RemoteTech", "Antenna_get_TargetBody", _args), [] (SpaceCenter::CelestialBody& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> RemoteTech::Antenna::set_target_body_async(SpaceCenter::CelestialBody value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("RemoteTech", "Antenna_set_TargetBody", _args));
+}
+
+inline ::krpc::Future<std::string> RemoteTech::Antenna::target_ground_station_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<std::string>(this->_client, this->_client->build_call("RemoteTech", "Antenna_get_TargetGroundStation", _args), [] (std::string& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> RemoteTech::Antenna::set_target_ground_station_async(std::string value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("RemoteTech", "Antenna_set_TargetGroundStation", _args));
+}
+
+inline ::krpc::Future<SpaceCenter::Vessel> RemoteTech::Antenna::target_vessel_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<SpaceCenter::Vessel>(this->_client, this->_client->build_call("RemoteTech", "Antenna_get_TargetVessel", _args), [] (SpaceCenter::Vessel& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> RemoteTech::Antenna::set_target_vessel_async(SpaceCenter::Vessel value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("RemoteTech", "Antenna_set_TargetVessel", _args));
+}
+
 inline RemoteTech::Comms::Comms(Client* client, uint64_t id):
   Object(client, "RemoteTech::Comms", id) {}
 
@@ -752,6 +883,61 @@ inline ::krpc::schema::ProcedureCall RemoteTech::Comms::vessel_call() {
   _args.push_back(encoder::encode(*this));
   return this->_client->build_call("RemoteTech", "Comms_get_Vessel", _args);
 }
+
+inline ::krpc::Future<double> RemoteTech::Comms::signal_delay_to_vessel_async(SpaceCenter::Vessel other) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(other));
+  return ::krpc::Future<double>(this->_client, this->_client->build_call("RemoteTech", "Comms_SignalDelayToVessel", _args), [] (double& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<std::vector<RemoteTech::Antenna>> RemoteTech::Comms::antennas_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<std::vector<RemoteTech::Antenna>>(this->_client, this->_client->build_call("RemoteTech", "Comms_get_Antennas", _args), [] (std::vector<RemoteTech::Antenna>& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<bool> RemoteTech::Comms::has_connection_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<bool>(this->_client, this->_client->build_call("RemoteTech", "Comms_get_HasConnection", _args), [] (bool& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<bool> RemoteTech::Comms::has_connection_to_ground_station_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<bool>(this->_client, this->_client->build_call("RemoteTech", "Comms_get_HasConnectionToGroundStation", _args), [] (bool& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<bool> RemoteTech::Comms::has_flight_computer_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<bool>(this->_client, this->_client->build_call("RemoteTech", "Comms_get_HasFlightComputer", _args), [] (bool& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<bool> RemoteTech::Comms::has_local_control_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<bool>(this->_client, this->_client->build_call("RemoteTech", "Comms_get_HasLocalControl", _args), [] (bool& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<double> RemoteTech::Comms::signal_delay_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<double>(this->_client, this->_client->build_call("RemoteTech", "Comms_get_SignalDelay", _args), [] (double& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<double> RemoteTech::Comms::signal_delay_to_ground_station_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<double>(this->_client, this->_client->build_call("RemoteTech", "Comms_get_SignalDelayToGroundStation", _args), [] (double& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<SpaceCenter::Vessel> RemoteTech::Comms::vessel_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<SpaceCenter::Vessel>(this->_client, this->_client->build_call("RemoteTech", "Comms_get_Vessel", _args), [] (SpaceCenter::Vessel& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
 }  // namespace services
 
 }  // namespace krpc
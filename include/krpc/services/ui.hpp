@@ -10,6 +10,7 @@
 #include <krpc/encoder.hpp>
 #include <krpc/error.hpp>
 #include <krpc/event.hpp>
+#include <krpc/future.hpp>
 #include <krpc/object.hpp>
 #include <krpc/service.hpp>
 #include <krpc/stream.hpp>
@@ -175,6 +176,14 @@ class UI : public Service {
 
   ::krpc::schema::ProcedureCall stock_canvas_call();
 
+  ::krpc::Future<UI::Canvas> add_canvas_async();
+
+  ::krpc::Future<void> clear_async(bool client_only);
+
+  ::krpc::Future<void> message_async(std::string content, float duration, UI::MessagePosition position, std::tuple<double, double, double> color, float size);
+
+  ::krpc::Future<UI::Canvas> stock_canvas_async();
+
   /**
    * A text label. See UI::Panel::add_button.
    */
@@ -244,6 +253,20 @@ class UI : public Service {
     ::krpc::schema::ProcedureCall visible_call();
 
     ::krpc::schema::ProcedureCall set_visible_call(bool value);
+
+    ::krpc::Future<void> remove_async();
+
+    ::krpc::Future<bool> clicked_async();
+
+    ::krpc::Future<void> set_clicked_async(bool value);
+
+    ::krpc::Future<UI::RectTransform> rect_transform_async();
+
+    ::krpc::Future<UI::Text> text_async();
+
+    ::krpc::Future<bool> visible_async();
+
+    ::krpc::Future<void> set_visible_async(bool value);
   };
 
   /**
@@ -326,6 +349,22 @@ class UI : public Service {
     ::krpc::schema::ProcedureCall visible_call();
 
     ::krpc::schema::ProcedureCall set_visible_call(bool value);
+
+    ::krpc::Future<UI::Button> add_button_async(std::string content, bool visible);
+
+    ::krpc::Future<UI::InputField> add_input_field_async(bool visible);
+
+    ::krpc::Future<UI::Panel> add_panel_async(bool visible);
+
+    ::krpc::Future<UI::Text> add_text_async(std::string content, bool visible);
+
+    ::krpc::Future<void> remove_async();
+
+    ::krpc::Future<UI::RectTransform> rect_transform_async();
+
+    ::krpc::Future<bool> visible_async();
+
+    ::krpc::Future<void> set_visible_async(bool value);
   };
 
   /**
@@ -416,6 +455,24 @@ class UI : public Service {
     ::krpc::schema::ProcedureCall visible_call();
 
     ::krpc::schema::ProcedureCall set_visible_call(bool value);
+
+    ::krpc::Future<void> remove_async();
+
+    ::krpc::Future<bool> changed_async();
+
+    ::krpc::Future<void> set_changed_async(bool value);
+
+    ::krpc::Future<UI::RectTransform> rect_transform_async();
+
+    ::krpc::Future<UI::Text> text_async();
+
+    ::krpc::Future<std::string> value_async();
+
+    ::krpc::Future<void> set_value_async(std::string value);
+
+    ::krpc::Future<bool> visible_async();
+
+    ::krpc::Future<void> set_visible_async(bool value);
   };
 
   /**
@@ -498,6 +555,22 @@ class UI : public Service {
     ::krpc::schema::ProcedureCall visible_call();
 
     ::krpc::schema::ProcedureCall set_visible_call(bool value);
+
+    ::krpc::Future<UI::Button> add_button_async(std::string content, bool visible);
+
+    ::krpc::Future<UI::InputField> add_input_field_async(bool visible);
+
+    ::krpc::Future<UI::Panel> add_panel_async(bool visible);
+
+    ::krpc::Future<UI::Text> add_text_async(std::string content, bool visible);
+
+    ::krpc::Future<void> remove_async();
+
+    ::krpc::Future<UI::RectTransform> rect_transform_async();
+
+    ::krpc::Future<bool> visible_async();
+
+    ::krpc::Future<void> set_visible_async(bool value);
   };
 
   /**
@@ -674,6 +747,48 @@ class UI : public Service {
     ::krpc::schema::ProcedureCall upper_right_call();
 
     ::krpc::schema::ProcedureCall set_upper_right_call(std::tuple<double, double> value);
+
+    ::krpc::Future<void> set_anchor_async(std::tuple<double, double> value);
+
+    ::krpc::Future<std::tuple<double, double>> anchor_max_async();
+
+    ::krpc::Future<void> set_anchor_max_async(std::tuple<double, double> value);
+
+    ::krpc::Future<std::tuple<double, double>> anchor_min_async();
+
+    ::krpc::Future<void> set_anchor_min_async(std::tuple<double, double> value);
+
+    ::krpc::Future<std::tuple<double, double, double>> local_position_async();
+
+    ::krpc::Future<void> set_local_position_async(std::tuple<double, double, double> value);
+
+    ::krpc::Future<std::tuple<double, double>> lower_left_async();
+
+    ::krpc::Future<void> set_lower_left_async(std::tuple<double, double> value);
+
+    ::krpc::Future<std::tuple<double, double>> pivot_async();
+
+    ::krpc::Future<void> set_pivot_async(std::tuple<double, double> value);
+
+    ::krpc::Future<std::tuple<double, double>> position_async();
+
+    ::krpc::Future<void> set_position_async(std::tuple<double, double> value);
+
+    ::krpc::Future<std::tuple<double, double, double, double>> rotation_async();
+
+    ::krpc::Future<void> set_rotation_async(std::tuple<double, double, double, double> value);
+
+    ::krpc::Future<std::tuple<double, double, double>> scale_async();
+
+    ::krpc::Future<void> set_scale_async(std::tuple<double, double, double> value);
+
+    ::krpc::Future<std::tuple<double, double>> size_async();
+
+    ::krpc::Future<void> set_size_async(std::tuple<double, double> value);
+
+    ::krpc::Future<std::tuple<double, double>> upper_right_async();
+
+    ::krpc::Future<void> set_upper_right_async(std::tuple<double, double> value);
   };
 
   /**
@@ -835,6 +950,44 @@ class UI : public Service {
     ::krpc::schema::ProcedureCall visible_call();
 
     ::krpc::schema::ProcedureCall set_visible_call(bool value);
+
+    ::krpc::Future<void> remove_async();
+
+    ::krpc::Future<UI::TextAnchor> alignment_async();
+
+    ::krpc::Future<void> set_alignment_async(UI::TextAnchor value);
+
+    ::krpc::Future<std::vector<std::string>> available_fonts_async();
+
+    ::krpc::Future<std::tuple<double, double, double>> color_async();
+
+    ::krpc::Future<void> set_color_async(std::tuple<double, double, double> value);
+
+    ::krpc::Future<std::string> content_async();
+
+    ::krpc::Future<void> set_content_async(std::string value);
+
+    ::krpc::Future<std::string> font_async();
+
+    ::krpc::Future<void> set_font_async(std::string value);
+
+    ::krpc::Future<float> line_spacing_async();
+
+    ::krpc::Future<void> set_line_spacing_async(float value);
+
+    ::krpc::Future<UI::RectTransform> rect_transform_async();
+
+    ::krpc::Future<int32_t> size_async();
+
+    ::krpc::Future<void> set_size_async(int32_t value);
+
+    ::krpc::Future<UI::FontStyle> style_async();
+
+    ::krpc::Future<void> set_style_async(UI::FontStyle value);
+
+    ::krpc::Future<bool> visible_async();
+
+    ::krpc::Future<void> set_visible_async(bool value);
   };
 };
 
@@ -956,6 +1109,30 @@ inline ::krpc::schema::ProcedureCall UI::stock_canvas_call() {
   return this->_client->build_call("UI", "get_StockCanvas");
 }
 
+inline ::krpc::Future<UI::Canvas> UI::add_canvas_async() {
+  return ::krpc::Future<UI::Canvas>(this->_client, this->_client->build_call("UI", "AddCanvas"), [] (UI::Canvas& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> UI::clear_async(bool client_only = false) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(client_only));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("UI", "Clear", _args));
+}
+
+inline ::krpc::Future<void> UI::message_async(std::string content, float duration = 1.0, UI::MessagePosition position = static_cast<UI::MessagePosition>(1), std::tuple<double, double, double> color = std::tuple<double, double, double>{1.0, 0.92, 0.016}, float size = 20.0) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(content));
+  _args.push_back(encoder::encode(duration));
+  _args.push_back(encoder::encode(position));
+  _args.push_back(encoder::encode(color));
+  _args.push_back(encoder::encode(size));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("UI", "Message", _args));
+}
+
+inline ::krpc::Future<UI::Canvas> UI::stock_canvas_async() {
+  return ::krpc::Future<UI::Canvas>(this->_client, this->_client->build_call("UI", "get_StockCanvas"), [] (UI::Canvas& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
 inline UI::Button::Button(Client* client, uint64_t id):
   Object(client, "UI::Button", id) {}
 
@@ -1083,6 +1260,50 @@ inline ::krpc::schema::ProcedureCall UI::Button::set_visible_call(bool value) {
   return this->_client->build_call("UI", "Button_set_Visible", _args);
 }
 
+inline ::krpc::Future<void> UI::Button::remove_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("UI", "Button_Remove", _args));
+}
+
+inline ::krpc::Future<bool> UI::Button::clicked_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<bool>(this->_client, this->_client->build_call("UI", "Button_get_Clicked", _args), [] (bool& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> UI::Button::set_clicked_async(bool value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("UI", "Button_set_Clicked", _args));
+}
+
+inline ::krpc::Future<UI::RectTransform> UI::Button::rect_transform_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<UI::RectTransform>(this->_client, this->_client->build_call("UI", "Button_get_RectTransform", _args), [] (UI::RectTransform& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<UI::Text> UI::Button::text_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<UI::Text>(this->_client, this->_client->build_call("UI", "Button_get_Text", _args), [] (UI::Text& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<bool> UI::Button::visible_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<bool>(this->_client, this->_client->build_call("UI", "Button_get_Visible", _args), [] (bool& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> UI::Button::set_visible_async(bool value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("UI", "Button_set_Visible", _args));
+}
+
 inline UI::Canvas::Canvas(Client* client, uint64_t id):
   Object(client, "UI::Canvas", id) {}
 
@@ -1256,6 +1477,61 @@ inline ::krpc::schema::ProcedureCall UI::Canvas::set_visible_call(bool value) {
   return this->_client->build_call("UI", "Canvas_set_Visible", _args);
 }
 
+inline ::krpc::Future<UI::Button> UI::Canvas::add_button_async(std::string content, bool visible = true) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(content));
+  _args.push_back(encoder::encode(visible));
+  return ::krpc::Future<UI::Button>(this->_client, this->_client->build_call("UI", "Canvas_AddButton", _args), [] (UI::Button& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<UI::InputField> UI::Canvas::add_input_field_async(bool visible = true) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(visible));
+  return ::krpc::Future<UI::InputField>(this->_client, this->_client->build_call("UI", "Canvas_AddInputField", _args), [] (UI::InputField& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<UI::Panel> UI::Canvas::add_panel_async(bool visible = true) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(visible));
+  return ::krpc::Future<UI::Panel>(this->_client, this->_client->build_call("UI", "Canvas_AddPanel", _args), [] (UI::Panel& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<UI::Text> UI::Canvas::add_text_async(std::string content, bool visible = true) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(content));
+  _args.push_back(encoder::encode(visible));
+  return ::krpc::Future<UI::Text>(this->_client, this->_client->build_call("UI", "Canvas_AddText", _args), [] (UI::Text& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> UI::Canvas::remove_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("UI", "Canvas_Remove", _args));
+}
+
+inline ::krpc::Future<UI::RectTransform> UI::Canvas::rect_transform_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<UI::RectTransform>(this->_client, this->_client->build_call("UI", "Canvas_get_RectTransform", _args), [] (UI::RectTransform& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<bool> UI::Canvas::visible_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<bool>(this->_client, this->_client->build_call("UI", "Canvas_get_Visible", _args), [] (bool& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> UI::Canvas::set_visible_async(bool value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("UI", "Canvas_set_Visible", _args));
+}
+
 inline UI::InputField::InputField(Client* client, uint64_t id):
   Object(client, "UI::InputField", id) {}
 
@@ -1418,6 +1694,63 @@ inline ::krpc::schema::ProcedureCall UI::InputField::set_visible_call(bool value
   return this->_client->build_call("UI", "InputField_set_Visible", _args);
 }
 
+inline ::krpc::Future<void> UI::InputField::remove_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("UI", "InputField_Remove", _args));
+}
+
+inline ::krpc::Future<bool> UI::InputField::changed_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<bool>(this->_client, this->_client->build_call("UI", "InputField_get_Changed", _args), [] (bool& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> UI::InputField::set_changed_async(bool value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("UI", "InputField_set_Changed", _args));
+}
+
+inline ::krpc::Future<UI::RectTransform> UI::InputField::rect_transform_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<UI::RectTransform>(this->_client, this->_client->build_call("UI", "InputField_get_RectTransform", _args), [] (UI::RectTransform& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<UI::Text> UI::InputField::text_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<UI::Text>(this->_client, this->_client->build_call("UI", "InputField_get_Text", _args), [] (UI::Text& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<std::string> UI::InputField::value_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<std::string>(this->_client, this->_client->build_call("UI", "InputField_get_Value", _args), [] (std::string& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> UI::InputField::set_value_async(std::string value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("UI", "InputField_set_Value", _args));
+}
+
+inline ::krpc::Future<bool> UI::InputField::visible_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<bool>(this->_client, this->_client->build_call("UI", "InputField_get_Visible", _args), [] (bool& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> UI::InputField::set_visible_async(bool value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("UI", "InputField_set_Visible", _args));
+}
+
 inline UI::Panel::Panel(Client* client, uint64_t id):
   Object(client, "UI::Panel", id) {}
 
@@ -1591,6 +1924,61 @@ inline ::krpc::schema::ProcedureCall UI::Panel::set_visible_call(bool value) {
   return this->_client->build_call("UI", "Panel_set_Visible", _args);
 }
 
+inline ::krpc::Future<UI::Button> UI::Panel::add_button_async(std::string content, bool visible = true) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(content));
+  _args.push_back(encoder::encode(visible));
+  return ::krpc::Future<UI::Button>(this->_client, this->_client->build_call("UI", "Panel_AddButton", _args), [] (UI::Button& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<UI::InputField> UI::Panel::add_input_field_async(bool visible = true) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(visible));
+  return ::krpc::Future<UI::InputField>(this->_client, this->_client->build_call("UI", "Panel_AddInputField", _args), [] (UI::InputField& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<UI::Panel> UI::Panel::add_panel_async(bool visible = true) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(visible));
+  return ::krpc::Future<UI::Panel>(this->_client, this->_client->build_call("UI", "Panel_AddPanel", _args), [] (UI::Panel& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<UI::Text> UI::Panel::add_text_async(std::string content, bool visible = true) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(content));
+  _args.push_back(encoder::encode(visible));
+  return ::krpc::Future<UI::Text>(this->_client, this->_client->build_call("UI", "Panel_AddText", _args), [] (UI::Text& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> UI::Panel::remove_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("UI", "Panel_Remove", _args));
+}
+
+inline ::krpc::Future<UI::RectTransform> UI::Panel::rect_transform_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<UI::RectTransform>(this->_client, this->_client->build_call("UI", "Panel_get_RectTransform", _args), [] (UI::RectTransform& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<bool> UI::Panel::visible_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<bool>(this->_client, this->_client->build_call("UI", "Panel_get_Visible", _args), [] (bool& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> UI::Panel::set_visible_async(bool value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("UI", "Panel_set_Visible", _args));
+}
+
 inline UI::RectTransform::RectTransform(Client* client, uint64_t id):
   Object(client, "UI::RectTransform", id) {}
 
@@ -1958,6 +2346,143 @@ inline ::krpc::schema::ProcedureCall UI::RectTransform::set_upper_right_call(std
   return this->_client->build_call("UI", "RectTransform_set_UpperRight", _args);
 }
 
+inline ::krpc::Future<void> UI::RectTransform::set_anchor_async(std::tuple<double, double> value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("UI", "RectTransform_set_Anchor", _args));
+}
+
+inline ::krpc::Future<std::tuple<double, double>> UI::RectTransform::anchor_max_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<std::tuple<double, double>>(this->_client, this->_client->build_call("UI", "RectTransform_get_AnchorMax", _args), [] (std::tuple<double, double>& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> UI::RectTransform::set_anchor_max_async(std::tuple<double, double> value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("UI", "RectTransform_set_AnchorMax", _args));
+}
+
+inline ::krpc::Future<std::tuple<double, double>> UI::RectTransform::anchor_min_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<std::tuple<double, double>>(this->_client, this->_client->build_call("UI", "RectTransform_get_AnchorMin", _args), [] (std::tuple<double, double>& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> UI::RectTransform::set_anchor_min_async(std::tuple<double, double> value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("UI", "RectTransform_set_AnchorMin", _args));
+}
+
+inline ::krpc::Future<std::tuple<double, double, double>> UI::RectTransform::local_position_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<std::tuple<double, double, double>>(this->_client, this->_client->build_call("UI", "RectTransform_get_LocalPosition", _args), [] (std::tuple<double, double, double>& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> UI::RectTransform::set_local_position_async(std::tuple<double, double, double> value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("UI", "RectTransform_set_LocalPosition", _args));
+}
+
+inline ::krpc::Future<std::tuple<double, double>> UI::RectTransform::lower_left_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<std::tuple<double, double>>(this->_client, this->_client->build_call("UI", "RectTransform_get_LowerLeft", _args), [] (std::tuple<double, double>& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> UI::RectTransform::set_lower_left_async(std::tuple<double, double> value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("UI", "RectTransform_set_LowerLeft", _args));
+}
+
+inline ::krpc::Future<std::tuple<double, double>> UI::RectTransform::pivot_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<std::tuple<double, double>>(this->_client, this->_client->build_call("UI", "RectTransform_get_Pivot", _args), [] (std::tuple<double, double>& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> UI::RectTransform::set_pivot_async(std::tuple<double, double> value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("UI", "RectTransform_set_Pivot", _args));
+}
+
+inline ::krpc::Future<std::tuple<double, double>> UI::RectTransform::position_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<std::tuple<double, double>>(this->_client, this->_client->build_call("UI", "RectTransform_get_Position", _args), [] (std::tuple<double, double>& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> UI::RectTransform::set_position_async(std::tuple<double, double> value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("UI", "RectTransform_set_Position", _args));
+}
+
+inline ::krpc::Future<std::tuple<double, double, double, double>> UI::RectTransform::rotation_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<std::tuple<double, double, double, double>>(this->_client, this->_client->build_call("UI", "RectTransform_get_Rotation", _args), [] (std::tuple<double, double, double, double>& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> UI::RectTransform::set_rotation_async(std::tuple<double, double, double, double> value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("UI", "RectTransform_set_Rotation", _args));
+}
+
+inline ::krpc::Future<std::tuple<double, double, double>> UI::RectTransform::scale_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<std::tuple<double, double, double>>(this->_client, this->_client->build_call("UI", "RectTransform_get_Scale", _args), [] (std::tuple<double, double, double>& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> UI::RectTransform::set_scale_async(std::tuple<double, double, double> value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("UI", "RectTransform_set_Scale", _args));
+}
+
+inline ::krpc::Future<std::tuple<double, double>> UI::RectTransform::size_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<std::tuple<double, double>>(this->_client, this->_client->build_call("UI", "RectTransform_get_Size", _args), [] (std::tuple<double, double>& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> UI::RectTransform::set_size_async(std::tuple<double, double> value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("UI", "RectTransform_set_Size", _args));
+}
+
+inline ::krpc::Future<std::tuple<double, double>> UI::RectTransform::upper_right_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<std::tuple<double, double>>(this->_client, this->_client->build_call("UI", "RectTransform_get_UpperRight", _args), [] (std::tuple<double, double>& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> UI::RectTransform::set_upper_right_async(std::tuple<double, double> value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("UI", "RectTransform_set_UpperRight", _args));
+}
+
 inline UI::Text::Text(Client* client, uint64_t id):
   Object(client, "UI::Text", id) {}
 
@@ -2294,6 +2819,128 @@ inline ::krpc::schema::ProcedureCall UI::Text::set_visible_call(bool value) {
   _args.push_back(encoder::encode(value));
   return this->_client->build_call("UI", "Text_set_Visible", _args);
 }
+
+inline ::krpc::Future<void> UI::Text::remove_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("UI", "Text_Remove", _args));
+}
+
+inline ::krpc::Future<UI::TextAnchor> UI::Text::alignment_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<UI::TextAnchor>(this->_client, this->_client->build_call("UI", "Text_get_Alignment", _args), [] (UI::TextAnchor& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> UI::Text::set_alignment_async(UI::TextAnchor value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("UI", "Text_set_Alignment", _args));
+}
+
+inline ::krpc::Future<std::vector<std::string>> UI::Text::available_fonts_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<std::vector<std::string>>(this->_client, this->_client->build_call("UI", "Text_get_AvailableFonts", _args), [] (std::vector<std::string>& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<std::tuple<double, double, double>> UI::Text::color_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<std::tuple<double, double, double>>(this->_client, this->_client->build_call("UI", "Text_get_Color", _args), [] (std::tuple<double, double, double>& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> UI::Text::set_color_async(std::tuple<double, double, double> value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("UI", "Text_set_Color", _args));
+}
+
+inline ::krpc::Future<std::string> UI::Text::content_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<std::string>(this->_client, this->_client->build_call("UI", "Text_get_Content", _args), [] (std::string& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> UI::Text::set_content_async(std::string value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("UI", "Text_set_Content", _args));
+}
+
+inline ::krpc::Future<std::string> UI::Text::font_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<std::string>(this->_client, this->_client->build_call("UI", "Text_get_Font", _args), [] (std::string& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> UI::Text::set_font_async(std::string value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("UI", "Text_set_Font", _args));
+}
+
+inline ::krpc::Future<float> UI::Text::line_spacing_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<float>(this->_client, this->_client->build_call("UI", "Text_get_LineSpacing", _args), [] (float& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> UI::Text::set_line_spacing_async(float value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("UI", "Text_set_LineSpacing", _args));
+}
+
+inline ::krpc::Future<UI::RectTransform> UI::Text::rect_transform_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<UI::RectTransform>(this->_client, this->_client->build_call("UI", "Text_get_RectTransform", _args), [] (UI::RectTransform& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<int32_t> UI::Text::size_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<int32_t>(this->_client, this->_client->build_call("UI", "Text_get_Size", _args), [] (int32_t& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> UI::Text::set_size_async(int32_t value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("UI", "Text_set_Size", _args));
+}
+
+inline ::krpc::Future<UI::FontStyle> UI::Text::style_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<UI::FontStyle>(this->_client, this->_client->build_call("UI", "Text_get_Style", _args), [] (UI::FontStyle& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> UI::Text::set_style_async(UI::FontStyle value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("UI", "Text_set_Style", _args));
+}
+
+inline ::krpc::Future<bool> UI::Text::visible_async() {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  return ::krpc::Future<bool>(this->_client, this->_client->build_call("UI", "Text_get_Visible", _args), [] (bool& _result, const std::string& _data, Client* _client) { decoder::decode(_result, _data, _client); });
+}
+
+inline ::krpc::Future<void> UI::Text::set_visible_async(bool value) {
+  std::vector<std::string> _args;
+  _args.push_back(encoder::encode(*this));
+  _args.push_back(encoder::encode(value));
+  return ::krpc::Future<void>(this->_client, this->_client->build_call("UI", "Text_set_Visible", _args));
+}
 }  // namespace services
 
 }  // namespace krpc
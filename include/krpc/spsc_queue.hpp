@@ -0,0 +1,93 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+namespace krpc {
+
+/**
+ * A bounded queue for one producer thread and one consumer thread, that never blocks
+ * or allocates memory. The slots are allocated when the queue is created and reused,
+ * so an element that holds memory, such as a string, keeps it for the next element
+ * written to the same slot.
+ */
+template <typename T>
+class SpscQueue {
+ public:
+  /** Create a queue. The capacity is rounded up to a power of two. */
+  explicit SpscQueue(size_t capacity);
+  /**
+   * Called by the producer to get the slot to write the next element to, or nullptr if
+   * the queue is full. The element is added by push().
+   */
+  T * next();
+  /** Called by the producer to add the element written to the slot returned by next(). */
+  void push();
+  /**
+   * Called by the consumer to get the oldest element, or nullptr if the queue is empty.
+   * The element is removed by pop().
+   */
+  T * front();
+  /** Called by the consumer to remove the element returned by front(). */
+  void pop();
+  size_t capacity() const;
+  /** The number of elements in the queue. Exact only when called by the producer or consumer. */
+  size_t size() const;
+
+ private:
+  SpscQueue(const SpscQueue&) = delete;
+  SpscQueue& operator=(const SpscQueue&) = delete;
+  static size_t round_up(size_t capacity);
+  std::vector<T> slots;
+  size_t mask;
+  /** Written by the consumer. Kept apart from tail, so the threads don't share a cache line. */
+  alignas(64) std::atomic<size_t> head;
+  alignas(64) std::atomic<size_t> tail;
+};
+
+template <typename T> inline SpscQueue<T>::SpscQueue(size_t capacity) :
+  slots(round_up(capacity)), mask(slots.size() - 1), head(0), tail(0) {
+}
+
+template <typename T> inline T * SpscQueue<T>::next() {
+  size_t position = tail.load(std::memory_order_relaxed);
+  if (position - head.load(std::memory_order_acquire) == slots.size())
+    return nullptr;
+  return &slots[position & mask];
+}
+
+template <typename T> inline void SpscQueue<T>::push() {
+  tail.store(tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+template <typename T> inline T * SpscQueue<T>::front() {
+  size_t position = head.load(std::memory_order_relaxed);
+  if (position == tail.load(std::memory_order_acquire))
+    return nullptr;
+  return &slots[position & mask];
+}
+
+template <typename T> inline void SpscQueue<T>::pop() {
+  head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+template <typename T> inline size_t SpscQueue<T>::capacity() const {
+  return slots.size();
+}
+
+template <typename T> inline size_t SpscQueue<T>::size() const {
+  return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+}
+
+template <typename T> inline size_t SpscQueue<T>::round_up(size_t capacity) {
+  if (capacity == 0)
+    throw std::invalid_argument("Queue capacity must be at least 1");
+  size_t result = 1;
+  while (result < capacity)
+    result <<= 1;
+  return result;
+}
+
+}  // namespace krpc
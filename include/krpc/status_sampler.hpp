@@ -0,0 +1,169 @@
+#pragma once
+
+#include <google/protobuf/stubs/port.h>
+
+#include <chrono>  // NOLINT(build/c++11)
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>  // NOLINT(build/c++11)
+#include <vector>
+
+#include "krpc/client.hpp"
+#include "krpc/client_stats.hpp"
+#include "krpc/krpc.pb.hpp"
+#include "krpc/stream.hpp"
+
+namespace krpc {
+
+/**
+ * The server's status at one point in time, together with the round trip times the client
+ * measured since the previous sample.
+ */
+struct StatusSample {
+  /** When the sample was received */
+  std::chrono::steady_clock::time_point time;
+  schema::Status status;
+  /**
+   * Number of calls made by the generated services since the previous sample. Zero unless
+   * statistics are enabled using Client::enable_stats().
+   */
+  google::protobuf::uint64 calls;
+  /** Mean round trip time of those calls, in seconds */
+  double round_trip;
+  /**
+   * The server's time budget for RPCs in each update, in seconds, from
+   * Status::max_time_per_update, which is in microseconds.
+   */
+  double budget;
+  /**
+   * Whether the server used its whole budget in its last update, so that RPCs were left
+   * waiting for the next update.
+   */
+  bool saturated;
+  /**
+   * The mean round trip time less the time the server spent executing RPCs in its last
+   * update, in seconds. This is time spent in the client, on the wire, or waiting for the
+   * server's next update.
+   */
+  double unaccounted;
+};
+
+/**
+ * Streams KRPC::get_status() in the background, and keeps the most recent samples. Each
+ * sample is correlated with the round trip times measured by Client::stats(), to tell
+ * whether latency comes from the server running out of its max_time_per_update budget, from
+ * executing the RPCs, or from elsewhere: the client process, the network, or waiting for
+ * the server's next update.
+ */
+class StatusSampler {
+ public:
+  /**
+   * Start sampling at the given rate, in Hertz, keeping at most the given number of
+   * samples. Statistics must be enabled on the client for round trip times to be included.
+   */
+  StatusSampler(Client* client, float rate = 1, size_t history = 600);
+  ~StatusSampler();
+  /** Change the sampling rate, in Hertz. */
+  void set_rate(float rate);
+  /** Returns true and sets the most recent sample, if one has been received. */
+  bool latest(StatusSample& sample) const;
+  /** The samples received, oldest first. */
+  std::vector<StatusSample> samples() const;
+
+ private:
+  StatusSampler(const StatusSampler&) = delete;
+  StatusSampler& operator=(const StatusSampler&) = delete;
+  struct State {
+    State(Client* client, size_t history);
+    void add(const schema::Status& status);
+    /** Sum the calls and round trip times, in nanoseconds, in the client's statistics */
+    void totals(google::protobuf::uint64& calls, double& round_trip) const;
+    Client* client;
+    size_t history;
+    std::mutex lock;
+    std::deque<StatusSample> samples;
+    /** Totals from the client statistics, at the previous sample */
+    google::protobuf::uint64 calls;
+    double round_trip;
+  };
+  std::shared_ptr<State> state;
+  Stream<schema::Status> stream;
+  int tag;
+};
+
+inline StatusSampler::StatusSampler(Client* client, float rate, size_t history) :
+  state(std::make_shared<State>(client, history)),
+  stream(client, client->build_call("KRPC", "GetStatus")) {
+  stream.set_rate(rate);
+  std::shared_ptr<State> state = this->state;
+  tag = stream.add_callback([state] (schema::Status status) {
+    state->add(status);
+  }, Delivery::latest_only);
+}
+
+inline StatusSampler::~StatusSampler() {
+  stream.remove_callback(tag);
+  stream.remove();
+}
+
+inline void StatusSampler::set_rate(float rate) {
+  stream.set_rate(rate);
+}
+
+inline bool StatusSampler::latest(StatusSample& sample) const {
+  std::lock_guard<std::mutex> guard(state->lock);
+  if (state->samples.empty())
+    return false;
+  sample = state->samples.back();
+  return true;
+}
+
+inline std::vector<StatusSample> StatusSampler::samples() const {
+  std::lock_guard<std::mutex> guard(state->lock);
+  return std::vector<StatusSample>(state->samples.begin(), state->samples.end());
+}
+
+inline StatusSampler::State::State(Client* client, size_t history) :
+  client(client), history(history) {
+  totals(calls, round_trip);
+}
+
+inline void StatusSampler::State::add(const schema::Status& status) {
+  StatusSample sample;
+  sample.time = std::chrono::steady_clock::now();
+  sample.status = status;
+  google::protobuf::uint64 total_calls;
+  double total_round_trip;
+  totals(total_calls, total_round_trip);
+  std::lock_guard<std::mutex> guard(lock);
+  // Statistics that were disabled and enabled again start from zero
+  if (total_calls < calls) {
+    calls = 0;
+    round_trip = 0;
+  }
+  sample.calls = total_calls - calls;
+  sample.round_trip = sample.calls > 0 ? (total_round_trip - round_trip) / sample.calls / 1e9 : 0;
+  calls = total_calls;
+  round_trip = total_round_trip;
+  sample.budget = status.max_time_per_update() / 1e6;
+  sample.saturated = status.time_per_rpc_update() >= sample.budget;
+  sample.unaccounted = sample.calls > 0 ?
+    sample.round_trip - status.exec_time_per_rpc_update() : 0;
+  samples.push_back(sample);
+  while (samples.size() > history)
+    samples.pop_front();
+}
+
+inline void StatusSampler::State::totals(google::protobuf::uint64& calls,
+                                         double& round_trip) const {
+  calls = 0;
+  round_trip = 0;
+  ClientStatsSnapshot stats = client->stats();
+  for (auto& procedure : stats.procedures) {
+    calls += procedure.round_trip.count;
+    round_trip += procedure.round_trip.mean * procedure.round_trip.count;
+  }
+}
+
+}  // namespace krpc
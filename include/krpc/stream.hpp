@@ -2,12 +2,15 @@
 
 #include <condition_variable>  // NOLINT(build/c++11)
 #include <map>
+#include <memory>
 #include <string>
 
 #include "krpc/client.hpp"
 #include "krpc/decoder.hpp"
 #include "krpc/error.hpp"
 #include "krpc/krpc.pb.hpp"
+#include "krpc/stream_cache.hpp"
+#include "krpc/stream_delivery.hpp"
 #include "krpc/stream_impl.hpp"
 
 namespace krpc {
@@ -26,6 +29,15 @@ class Stream {
   void set_rate(float value);
   /** Get the most recent value for this stream. */
   T operator()();
+  /** Get the most recent value for this stream, and its sequence number. */
+  T get(google::protobuf::uint64& sequence);
+  /**
+   * The sequence number of the most recent update. Updates to a stream are numbered
+   * from 1, in the order they are received.
+   */
+  google::protobuf::uint64 sequence();
+  /** Counters for the updates received by this stream. */
+  StreamStats stats();
   /** Condition variable that is notified when the stream updates */
   std::condition_variable& get_condition() const;
   /** Lock used with the condition variable */
@@ -43,8 +55,12 @@ class Stream {
    * Returns an integer tag for the callback which uniquely identifies it,
    * and allows it to be removed using remove_callback()
    */
-  int add_callback(const Callback& callback);
-  /** Remove a callback, based on its tag */
+  int add_callback(const Callback& callback, Delivery delivery = Delivery::every_update);
+  /**
+   * Remove a callback, based on its tag. A callback that runs on a callback executor,
+   * or uses Delivery::latest_only, may still be running when this returns, but is not
+   * invoked again.
+   */
   void remove_callback(int tag);
   void remove();
   bool operator==(const Stream<T>& rhs) const;
@@ -53,9 +69,31 @@ class Stream {
 
  private:
   friend class Event;
+  template <typename... Ts> friend class Frame;
+  friend class Recorder;
+  friend class Selector;
+  /**
+   * Deleter for a shared_ptr to the StreamImpl that also owns the stream's cache.
+   * Reads find the cache using std::get_deleter, rather than searching the stream's
+   * callbacks, without changing the layout of Stream. It is installed when the Stream is
+   * constructed, and shared by its copies, so reads never modify impl. Streams constructed
+   * by the compiled library, such as Event::stream(), have no holder.
+   */
+  struct CacheHolder {
+    std::shared_ptr<StreamImpl> impl;
+    std::shared_ptr<StreamCache<T>> cache;
+    void operator()(StreamImpl *) {
+      impl.reset();
+      cache.reset();
+    }
+  };
+  /** Returns a pointer to a stream that owns the stream's cache. */
+  static std::shared_ptr<StreamImpl> hold(const std::shared_ptr<StreamImpl>& stream);
   std::shared_ptr<StreamImpl> impl;
   bool acquired;
   void check_exists() const;
+  /** The stream's cache, found by searching its callbacks if it has no CacheHolder. */
+  std::shared_ptr<StreamCache<T>> cache() const;
 };
 
 template <typename T> inline Stream<T>::Stream() :
@@ -63,11 +101,11 @@ template <typename T> inline Stream<T>::Stream() :
 }
 
 template <typename T> inline Stream<T>::Stream(Client* client, const schema::ProcedureCall& call) :
-  impl(client->add_stream(call)), acquired(false) {
+  impl(hold(client->add_stream(call))), acquired(false) {
 }
 
 template <typename T> inline Stream<T>::Stream(Client* client, google::protobuf::uint64 id) :
-  impl(client->get_stream(id)), acquired(false) {
+  impl(hold(client->get_stream(id))), acquired(false) {
 }
 
 template <typename T> inline void Stream<T>::start(bool wait) {
@@ -100,10 +138,24 @@ template <typename T> inline T Stream<T>::operator()() {
   check_exists();
   if (!impl->has_started())
     start();
-  std::string data = impl->get_data();
-  T value;
-  decoder::decode(value, data, impl->get_client());
-  return value;
+  return cache()->get_value(impl.get());
+}
+
+template <typename T> inline T Stream<T>::get(google::protobuf::uint64& sequence) {
+  check_exists();
+  if (!impl->has_started())
+    start();
+  return cache()->get_value(impl.get(), &sequence);
+}
+
+template <typename T> inline google::protobuf::uint64 Stream<T>::sequence() {
+  check_exists();
+  return cache()->sequence();
+}
+
+template <typename T> inline StreamStats Stream<T>::stats() {
+  check_exists();
+  return cache()->stats();
 }
 
 template <typename T> inline std::condition_variable& Stream<T>::get_condition() const {
@@ -140,19 +192,15 @@ template <typename T> inline void Stream<T>::wait(double timeout) {
   }
 }
 
-template <typename T> inline int Stream<T>::add_callback(const Callback& callback) {
+template <typename T> inline int Stream<T>::add_callback(const Callback& callback,
+                                                         Delivery delivery) {
   check_exists();
-  auto callback_wrapper = [this, callback] (const std::string& data) {
-    T value;
-    decoder::decode(value, data, this->impl->get_client());
-    callback(value);
-  };
-  return impl->add_callback(callback_wrapper);
+  return cache()->add_callback(impl.get(), callback, delivery);
 }
 
 template <typename T> inline void Stream<T>::remove_callback(int tag) {
   check_exists();
-  impl->remove_callback(tag);
+  cache()->remove_callback(impl.get(), tag);
 }
 
 template <typename T> inline void Stream<T>::remove() {
@@ -186,4 +234,19 @@ template <typename T> inline void Stream<T>::check_exists() const {
     throw StreamError("Stream does not exist or was removed");
 }
 
+template <typename T> inline std::shared_ptr<StreamImpl> Stream<T>::hold(
+  const std::shared_ptr<StreamImpl>& stream) {
+  if (!stream)
+    return stream;
+  return std::shared_ptr<StreamImpl>(
+    stream.get(), CacheHolder{stream, StreamCache<T>::get(stream.get())});
+}
+
+template <typename T> inline std::shared_ptr<StreamCache<T>> Stream<T>::cache() const {
+  CacheHolder* holder = std::get_deleter<CacheHolder>(impl);
+  if (holder)
+    return holder->cache;
+  return StreamCache<T>::get(impl.get());
+}
+
 }  // namespace krpc
@@ -0,0 +1,323 @@
+#pragma once
+
+#include <google/protobuf/stubs/port.h>
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>  // NOLINT(build/c++11)
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "krpc/decoder.hpp"
+#include "krpc/seqlock.hpp"
+#include "krpc/stream_delivery.hpp"
+#include "krpc/stream_impl.hpp"
+
+namespace krpc {
+
+class Client;
+
+/**
+ * Holds a value that is replaced by one thread and copied by others. The value is
+ * published using an atomic shared_ptr, so is used for types that cannot be held
+ * in a SeqLock. Has the same interface as SeqLock.
+ */
+template <typename T>
+class SharedValue {
+ public:
+  SharedValue();
+  void store(T value);
+  void clear();
+  bool load(T& value) const;
+  bool load(T& value, google::protobuf::uint64& version) const;
+  google::protobuf::uint64 version() const;
+
+ private:
+  struct Slot {
+    bool valid;
+    T value;
+    google::protobuf::uint64 version;
+  };
+  std::shared_ptr<const Slot> slot;
+  /** Only accessed by the writer */
+  google::protobuf::uint64 writes;
+};
+
+template <typename T> inline SharedValue<T>::SharedValue() :
+  slot(std::make_shared<Slot>(Slot{false, T(), 0})), writes(0) {
+}
+
+template <typename T> inline void SharedValue<T>::store(T value) {
+  std::shared_ptr<const Slot> next = std::make_shared<Slot>(Slot{true, std::move(value), ++writes});
+  std::atomic_store(&slot, next);
+}
+
+template <typename T> inline void SharedValue<T>::clear() {
+  std::shared_ptr<const Slot> next = std::make_shared<Slot>(Slot{false, T(), ++writes});
+  std::atomic_store(&slot, next);
+}
+
+template <typename T> inline bool SharedValue<T>::load(T& value) const {
+  google::protobuf::uint64 version;
+  return load(value, version);
+}
+
+template <typename T> inline bool SharedValue<T>::load(
+  T& value, google::protobuf::uint64& version) const {
+  std::shared_ptr<const Slot> current = std::atomic_load(&slot);
+  version = current->version;
+  if (!current->valid)
+    return false;
+  value = current->value;
+  return true;
+}
+
+template <typename T> inline google::protobuf::uint64 SharedValue<T>::version() const {
+  return std::atomic_load(&slot)->version;
+}
+
+/**
+ * Selects how a value of type T is published to readers: in a SeqLock if possible,
+ * otherwise in a SharedValue.
+ */
+template <typename T>
+struct PublishedValue {
+  typedef typename std::conditional<PlainValue<T>::value, SeqLock<T>, SharedValue<T>>::type type;
+};
+
+/** Counters for the updates received by a stream. */
+struct StreamStats {
+  /** Number of updates received */
+  google::protobuf::uint64 updates;
+  /** Number of times a callback was invoked */
+  google::protobuf::uint64 delivered;
+  /** Number of updates skipped by callbacks that use Delivery::latest_only */
+  google::protobuf::uint64 coalesced;
+};
+
+/**
+ * The decoded value of a stream, shared by all Stream<T> objects and callbacks for the
+ * same stream. The cache is stored in the stream's callbacks, so it decodes each update
+ * once, on the stream update thread, and publishes the value for readers to copy without
+ * taking the stream's update lock. Numbers, and tuples of numbers, are published in a
+ * SeqLock, so reading them never waits for a lock or allocates memory.
+ */
+template <typename T>
+class StreamCache {
+ public:
+  explicit StreamCache(Client * client);
+  /** Returns the cache for a stream, creating it if necessary. */
+  static std::shared_ptr<StreamCache<T>> get(StreamImpl * impl);
+  /**
+   * Returns the most recent value of the stream. If sequence is not null, it is set
+   * to the sequence number of the value.
+   */
+  T get_value(StreamImpl * impl, google::protobuf::uint64 * sequence = nullptr) const;
+  /**
+   * Copy the most recently decoded value. Returns false if the last update
+   * could not be decoded.
+   */
+  bool load(T& value) const;
+  /** Copy the most recently decoded value, and its sequence number. */
+  bool load(T& value, google::protobuf::uint64& sequence) const;
+  /**
+   * The sequence number of the most recent update. Updates are numbered from 1, in the
+   * order they are received, starting from when the cache was created.
+   */
+  google::protobuf::uint64 sequence() const;
+  StreamStats stats() const;
+  typedef std::function<void(T)> Callback;
+  /** Add a callback to the stream. Returns its tag. */
+  int add_callback(StreamImpl * impl, const Callback& callback, Delivery delivery);
+  /** Remove a callback from the stream. */
+  void remove_callback(StreamImpl * impl, int tag);
+
+ private:
+  /** State of a callback that uses Delivery::latest_only */
+  struct Latest {
+    std::shared_ptr<StreamCache<T>> cache;
+    Callback callback;
+    std::shared_ptr<Strand> strand;
+    /** Whether the callback has been posted to its strand, and not yet run */
+    std::atomic<bool> pending;
+    /** Sequence number of the last value delivered. Only accessed from the strand. */
+    google::protobuf::uint64 delivered;
+    static void notify(const std::shared_ptr<Latest>& latest);
+    void run();
+  };
+  /** Callback that decodes the stream's value when it updates */
+  struct Updater {
+    std::shared_ptr<StreamCache<T>> cache;
+    void operator()(const std::string& data) const { cache->update(data); }
+  };
+  void update(const std::string& data);
+  Client * client;
+  typename PublishedValue<T>::type value;
+  std::atomic<google::protobuf::uint64> delivered;
+  std::atomic<google::protobuf::uint64> coalesced;
+  /** Strands of the callbacks that are run on an executor, by tag */
+  std::mutex strands_lock;
+  std::map<int, std::weak_ptr<Strand>> strands;
+};
+
+template <typename T> inline StreamCache<T>::StreamCache(Client * client) :
+  client(client), delivered(0), coalesced(0) {
+}
+
+template <typename T> inline std::shared_ptr<StreamCache<T>> StreamCache<T>::get(
+  StreamImpl * impl) {
+  std::lock_guard<std::recursive_mutex> guard(*impl->update_lock);
+  const StreamImpl::Callbacks& callbacks = impl->get_callbacks();
+  for (auto& callback : callbacks) {
+    const Updater* updater = callback.second.template target<Updater>();
+    if (updater)
+      return updater->cache;
+  }
+  std::shared_ptr<StreamCache<T>> cache = std::make_shared<StreamCache<T>>(impl->get_client());
+  if (impl->has_updated()) {
+    try {
+      cache->update(impl->get_data());
+    } catch (...) {
+      // Leave the cache empty, so that readers raise the stream's exception
+    }
+  }
+  impl->add_callback(Updater{cache});
+  return cache;
+}
+
+template <typename T> inline T StreamCache<T>::get_value(
+  StreamImpl * impl, google::protobuf::uint64 * sequence) const {
+  T result;
+  google::protobuf::uint64 version;
+  bool loaded = value.load(result, version);
+  if (sequence)
+    *sequence = version;
+  if (loaded)
+    return result;
+  // The last update could not be decoded. Decode it again, raising the stream's
+  // exception if it has one.
+  std::lock_guard<std::recursive_mutex> guard(*impl->update_lock);
+  const std::string& data = impl->get_data();
+  decoder::decode(result, data.data(), data.size(), client);
+  return result;
+}
+
+template <typename T> inline bool StreamCache<T>::load(T& value) const {
+  return this->value.load(value);
+}
+
+template <typename T> inline bool StreamCache<T>::load(
+  T& value, google::protobuf::uint64& sequence) const {
+  return this->value.load(value, sequence);
+}
+
+template <typename T> inline google::protobuf::uint64 StreamCache<T>::sequence() const {
+  return value.version();
+}
+
+template <typename T> inline StreamStats StreamCache<T>::stats() const {
+  StreamStats result;
+  result.updates = sequence();
+  result.delivered = delivered;
+  result.coalesced = coalesced;
+  return result;
+}
+
+template <typename T> inline int StreamCache<T>::add_callback(
+  StreamImpl * impl, const Callback& callback, Delivery delivery) {
+  std::shared_ptr<StreamCache<T>> cache = get(impl);
+  std::shared_ptr<CallbackExecutor> executor = CallbackExecutor::get(client);
+  if (delivery == Delivery::every_update && !executor) {
+    // The cache's callback was added to the stream first, so is invoked first,
+    // and has already decoded the value when this callback is invoked
+    return impl->add_callback([cache, callback] (const std::string&) {
+      T value;
+      if (cache->load(value)) {
+        cache->delivered++;
+        callback(value);
+      }
+    });
+  }
+  if (!executor)
+    executor = DeliveryThread::get();
+  std::shared_ptr<Strand> strand = std::make_shared<Strand>(executor);
+  StreamImpl::Callback wrapper;
+  if (delivery == Delivery::every_update) {
+    wrapper = [cache, callback, strand] (const std::string&) {
+      T value;
+      if (cache->load(value)) {
+        strand->post([cache, callback, value] {
+          cache->delivered++;
+          callback(value);
+        });
+      }
+    };
+  } else {
+    std::shared_ptr<Latest> latest = std::make_shared<Latest>();
+    latest->cache = cache;
+    latest->callback = callback;
+    latest->strand = strand;
+    latest->pending = false;
+    latest->delivered = 0;
+    wrapper = [latest] (const std::string&) { Latest::notify(latest); };
+  }
+  std::lock_guard<std::mutex> guard(strands_lock);
+  for (auto it = strands.begin(); it != strands.end();) {
+    if (it->second.expired())
+      it = strands.erase(it);
+    else
+      ++it;
+  }
+  int tag = impl->add_callback(wrapper);
+  strands[tag] = strand;
+  return tag;
+}
+
+template <typename T> inline void StreamCache<T>::remove_callback(StreamImpl * impl, int tag) {
+  impl->remove_callback(tag);
+  std::lock_guard<std::mutex> guard(strands_lock);
+  auto it = strands.find(tag);
+  if (it == strands.end())
+    return;
+  std::shared_ptr<Strand> strand = it->second.lock();
+  if (strand)
+    strand->close();
+  strands.erase(it);
+}
+
+template <typename T> inline void StreamCache<T>::Latest::notify(
+  const std::shared_ptr<Latest>& latest) {
+  if (latest->pending.exchange(true)) {
+    latest->cache->coalesced++;
+    return;
+  }
+  latest->strand->post([latest] { latest->run(); });
+}
+
+template <typename T> inline void StreamCache<T>::Latest::run() {
+  pending = false;
+  T value;
+  google::protobuf::uint64 sequence;
+  // Skip the value if it was already delivered by an earlier run
+  if (!cache->load(value, sequence) || sequence == delivered)
+    return;
+  delivered = sequence;
+  cache->delivered++;
+  callback(value);
+}
+
+template <typename T> inline void StreamCache<T>::update(const std::string& data) {
+  T decoded;
+  try {
+    decoder::decode(decoded, data.data(), data.size(), client);
+  } catch (...) {
+    value.clear();
+    return;
+  }
+  value.store(std::move(decoded));
+}
+
+}  // namespace krpc
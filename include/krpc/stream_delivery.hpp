@@ -0,0 +1,102 @@
+#pragma once
+
+#include <condition_variable>  // NOLINT(build/c++11)
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>  // NOLINT(build/c++11)
+#include <thread>  // NOLINT(build/c++11)
+
+#include "krpc/callback_executor.hpp"
+
+namespace krpc {
+
+/** How stream updates are delivered to a callback. */
+enum struct Delivery {
+  /**
+   * The callback is invoked once for every update, on the stream update thread or the
+   * client's callback executor.
+   */
+  every_update,
+  /**
+   * The callback is invoked with the most recent value, on the client's callback executor,
+   * or the delivery thread if it does not have one. Updates received while the callback is
+   * waiting to run, or running, are coalesced, so a slow callback skips updates rather
+   * than delaying the stream update thread.
+   */
+  latest_only
+};
+
+/**
+ * A thread that runs callbacks that use Delivery::latest_only, for clients that do not
+ * have a callback executor.
+ */
+class DeliveryThread : public CallbackExecutor {
+ public:
+  /** Returns the delivery thread, starting it if necessary. */
+  static const std::shared_ptr<DeliveryThread>& get();
+  ~DeliveryThread();
+  /** Run a task on the delivery thread. Tasks run in the order they are posted. */
+  void post(const Task& task) override;
+
+ private:
+  DeliveryThread();
+  DeliveryThread(const DeliveryThread&) = delete;
+  DeliveryThread& operator=(const DeliveryThread&) = delete;
+  void main();
+  std::mutex lock;
+  std::condition_variable condition;
+  std::deque<Task> tasks;
+  bool stop;
+  std::thread thread;
+};
+
+inline const std::shared_ptr<DeliveryThread>& DeliveryThread::get() {
+  static DeliveryThread delivery;
+  // Does not own the thread, so strands holding a weak reference to it see it expire
+  // at exit, before it is destroyed
+  static std::shared_ptr<DeliveryThread> pointer(&delivery, [] (DeliveryThread *) {});
+  return pointer;
+}
+
+inline DeliveryThread::DeliveryThread() : stop(false) {
+  thread = std::thread(&DeliveryThread::main, this);
+}
+
+inline DeliveryThread::~DeliveryThread() {
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    stop = true;
+  }
+  condition.notify_all();
+  thread.join();
+}
+
+inline void DeliveryThread::post(const Task& task) {
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    tasks.push_back(task);
+  }
+  condition.notify_one();
+}
+
+inline void DeliveryThread::main() {
+  while (true) {
+    Task task;
+    {
+      std::unique_lock<std::mutex> guard(lock);
+      condition.wait(guard, [this] { return stop || !tasks.empty(); });
+      if (tasks.empty())
+        return;
+      task.swap(tasks.front());
+      tasks.pop_front();
+    }
+    try {
+      task();
+    } catch (...) {
+      // Exceptions thrown by callbacks are discarded, as there is no caller to raise them in
+    }
+  }
+}
+
+}  // namespace krpc
@@ -12,6 +12,7 @@
 namespace krpc {
 
 class Client;
+template <typename T> class StreamCache;
 
 class StreamImpl {
  public:
@@ -35,6 +36,7 @@ class StreamImpl {
   void remove();
 
  private:
+  template <typename T> friend class StreamCache;
   Client * client;
   google::protobuf::uint64 id;
   std::recursive_mutex * update_lock;
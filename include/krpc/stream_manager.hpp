@@ -36,6 +36,8 @@ class StreamManager {
   typedef std::map<int, Callback> Callbacks;
   int add_update_callback(const Callback& callback);
   void remove_update_callback(int tag);
+  /** The stream connection */
+  const std::shared_ptr<Connection>& get_connection() const;
 
  private:
   static void update_thread_main(StreamManager* stream_manager,
@@ -58,4 +60,8 @@ class StreamManager {
   int next_callback_tag;
 };
 
+inline const std::shared_ptr<Connection>& StreamManager::get_connection() const {
+  return connection;
+}
+
 }  // namespace krpc
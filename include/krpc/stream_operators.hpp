@@ -0,0 +1,487 @@
+#pragma once
+
+#include <google/protobuf/stubs/port.h>
+
+#include <chrono>  // NOLINT(build/c++11)
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>  // NOLINT(build/c++11)
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "krpc/error.hpp"
+#include "krpc/seqlock.hpp"
+#include "krpc/stream.hpp"
+#include "krpc/stream_cache.hpp"
+#include "krpc/stream_delivery.hpp"
+
+namespace krpc {
+
+template <typename S> struct DerivedSource;
+
+/**
+ * A value computed from the updates of a stream, or of another derived value, using
+ * map(), window(), derivative(), ema() or throttle(). The value is computed incrementally
+ * by a callback on the source, so on the stream update thread, or the client's callback
+ * executor, and is published like the value of a stream, so reading it does not take a
+ * lock. Copies share the same value, and the computation stops when the last copy is
+ * destroyed.
+ */
+template <typename T>
+class Derived {
+ public:
+  typedef std::function<void(const T&)> Callback;
+  Derived();
+  /** The most recent value. Throws StreamError if no value has been computed. */
+  T operator()() const;
+  /** Copy the most recent value. Returns false if no value has been computed. */
+  bool get(T& value) const;
+  bool get(T& value, google::protobuf::uint64& sequence) const;
+  /** The number of values computed so far. */
+  google::protobuf::uint64 sequence() const;
+  /**
+   * Add a callback that is invoked with each new value, on the thread that computed it.
+   * Returns a tag that can be passed to remove_callback().
+   */
+  int add_callback(const Callback& callback);
+  void remove_callback(int tag);
+  explicit operator bool() const;
+
+  /**
+   * Create a value derived from a Stream or another Derived. step is called with each
+   * value of the source, and the output of the previous step, and returns true if it
+   * sets a new output.
+   */
+  template <typename S>
+  static Derived<T> create(
+    const S& source,
+    const std::function<bool(const typename DerivedSource<S>::Value&, T&)>& step);
+
+ private:
+  struct Node {
+    typename PublishedValue<T>::type value;
+    std::recursive_mutex lock;
+    std::vector<std::pair<int, Callback>> callbacks;
+    int next_tag;
+    /** Non-zero while the callbacks are running, when removed callbacks are only cleared */
+    int publishing;
+    bool removed;
+    /** Removes the callback from the source */
+    std::function<void()> unsubscribe;
+    Node() : next_tag(0), publishing(0), removed(false) {}
+    ~Node() {
+      if (unsubscribe)
+        unsubscribe();
+    }
+    void publish(const T& value);
+  };
+  template <typename S> friend struct DerivedSource;
+  explicit Derived(const std::shared_ptr<Node>& node);
+  void check_exists() const;
+  std::shared_ptr<Node> node;
+};
+
+/** Adapts a Stream or a Derived as the source of a derived value. */
+template <typename T>
+struct DerivedSource<Stream<T>> {
+  typedef T Value;
+  static std::function<void()> subscribe(const Stream<T>& stream,
+                                         const std::function<void(const T&)>& callback) {
+    Stream<T> source = stream;
+    source.start(false);
+    int tag = source.add_callback([callback] (T value) {
+      int& depth = dispatching();
+      depth++;
+      try {
+        callback(value);
+      } catch (...) {
+        depth--;
+        throw;
+      }
+      depth--;
+    });
+    return [source, tag] () mutable {
+      // The stream can't remove a callback while it is invoking its callbacks, which is
+      // where the last copy of a derived value is dropped if a callback drops it. The
+      // callback only holds a weak reference to the node, so does nothing until removed.
+      if (dispatching() > 0)
+        DeliveryThread::get()->post([source, tag] () mutable { source.remove_callback(tag); });
+      else
+        source.remove_callback(tag);
+    };
+  }
+  /** The number of stream callbacks running on this thread */
+  static int& dispatching() {
+    static thread_local int depth = 0;
+    return depth;
+  }
+};
+
+template <typename T>
+struct DerivedSource<Derived<T>> {
+  typedef T Value;
+  static std::function<void()> subscribe(const Derived<T>& derived,
+                                         const std::function<void(const T&)>& callback) {
+    derived.check_exists();
+    std::shared_ptr<typename Derived<T>::Node> node = derived.node;
+    Derived<T> source(node);
+    int tag = source.add_callback(callback);
+    // Holds the source node, so that intermediate values are kept alive
+    return [source, tag] () mutable { source.remove_callback(tag); };
+  }
+};
+
+/** The minimum, maximum and mean of the most recent values of a stream. */
+template <typename T>
+struct WindowStats {
+  T min;
+  T max;
+  double mean;
+  /** Number of values in the window, which is less than its size until it fills */
+  google::protobuf::uint64 count;
+};
+
+template <typename T>
+struct PlainValue<WindowStats<T>, typename std::enable_if<PlainValue<T>::value>::type> {
+  typedef std::tuple<T, T, double, google::protobuf::uint64> Tuple;
+  static const bool value = true;
+  static const size_t size = PlainValue<Tuple>::size;
+  static void pack(const WindowStats<T>& x, unsigned char* data) {
+    PlainValue<Tuple>::pack(Tuple(x.min, x.max, x.mean, x.count), data);
+  }
+  static void unpack(const unsigned char* data, WindowStats<T>& x) {
+    Tuple values;
+    PlainValue<Tuple>::unpack(data, values);
+    std::tie(x.min, x.max, x.mean, x.count) = values;
+  }
+};
+
+/**
+ * A queue with a fixed capacity, allocated when it is created. Pushing to a full
+ * buffer overwrites the oldest element.
+ */
+template <typename T>
+class RingBuffer {
+ public:
+  explicit RingBuffer(size_t capacity);
+  void push_back(const T& value);
+  void pop_front();
+  void pop_back();
+  const T& front() const;
+  const T& back() const;
+  size_t size() const;
+  bool empty() const;
+  bool full() const;
+
+ private:
+  std::vector<T> data;
+  size_t start;
+  size_t count;
+};
+
+/** Apply a function to each value of a stream. */
+template <typename S, typename F>
+Derived<typename std::decay<decltype(std::declval<F>()(
+  std::declval<const typename DerivedSource<S>::Value&>()))>::type>
+map(const S& source, F function);
+
+/** The minimum, maximum and mean of the last size values of a stream. */
+template <typename S>
+Derived<WindowStats<typename DerivedSource<S>::Value>> window(const S& source, size_t size);
+
+/**
+ * The rate of change of a stream, per second of the given clock. The first value is
+ * computed from the second update. The default clock is the client's steady clock; to
+ * differentiate with respect to game time, pass a clock that reads the universal time.
+ */
+template <typename S>
+Derived<double> derivative(const S& source, const std::function<double()>& clock = nullptr);
+
+/**
+ * An exponential moving average of a stream, a low pass filter. Each update moves the
+ * average by alpha, between 0 and 1, of its difference from the new value.
+ */
+template <typename S>
+Derived<double> ema(const S& source, double alpha);
+
+/** The values of a stream, at most one per interval seconds of the steady clock. */
+template <typename S>
+Derived<typename DerivedSource<S>::Value> throttle(const S& source, double interval);
+
+template <typename T> inline Derived<T>::Derived() {}
+
+template <typename T> inline Derived<T>::Derived(const std::shared_ptr<Node>& node) :
+  node(node) {
+}
+
+template <typename T> inline T Derived<T>::operator()() const {
+  T value;
+  if (!get(value))
+    throw StreamError("No value has been computed");
+  return value;
+}
+
+template <typename T> inline bool Derived<T>::get(T& value) const {
+  check_exists();
+  return node->value.load(value);
+}
+
+template <typename T> inline bool Derived<T>::get(
+  T& value, google::protobuf::uint64& sequence) const {
+  check_exists();
+  return node->value.load(value, sequence);
+}
+
+template <typename T> inline google::protobuf::uint64 Derived<T>::sequence() const {
+  check_exists();
+  return node->value.version();
+}
+
+template <typename T> inline int Derived<T>::add_callback(const Callback& callback) {
+  check_exists();
+  std::lock_guard<std::recursive_mutex> guard(node->lock);
+  int tag = node->next_tag++;
+  node->callbacks.push_back(std::make_pair(tag, callback));
+  return tag;
+}
+
+template <typename T> inline void Derived<T>::remove_callback(int tag) {
+  check_exists();
+  std::lock_guard<std::recursive_mutex> guard(node->lock);
+  for (auto it = node->callbacks.begin(); it != node->callbacks.end(); ++it) {
+    if (it->first != tag)
+      continue;
+    if (node->publishing > 0) {
+      // Removed once the callbacks have finished running
+      it->second = nullptr;
+      node->removed = true;
+    } else {
+      node->callbacks.erase(it);
+    }
+    return;
+  }
+}
+
+template <typename T> inline Derived<T>::operator bool() const {
+  return node != nullptr;
+}
+
+template <typename T> template <typename S> inline Derived<T> Derived<T>::create(
+  const S& source,
+  const std::function<bool(const typename DerivedSource<S>::Value&, T&)>& step) {
+  std::shared_ptr<Node> node = std::make_shared<Node>();
+  std::weak_ptr<Node> target = node;
+  typedef typename DerivedSource<S>::Value Input;
+  // The source's callback only holds a weak reference to the node, so that the node
+  // can be destroyed, which removes the callback
+  std::shared_ptr<T> output = std::make_shared<T>();
+  node->unsubscribe = DerivedSource<S>::subscribe(
+    source, [target, step, output] (const Input& input) {
+      std::shared_ptr<Node> node = target.lock();
+      if (node && step(input, *output))
+        node->publish(*output);
+    });
+  return Derived<T>(node);
+}
+
+template <typename T> inline void Derived<T>::check_exists() const {
+  if (!node)
+    throw StreamError("Derived value does not exist");
+}
+
+template <typename T> inline void Derived<T>::Node::publish(const T& next) {
+  value.store(next);
+  std::lock_guard<std::recursive_mutex> guard(lock);
+  publishing++;
+  // Callbacks added while publishing are not invoked until the next value
+  size_t size = callbacks.size();
+  for (size_t i = 0; i < size; i++) {
+    if (callbacks[i].second)
+      callbacks[i].second(next);
+  }
+  publishing--;
+  if (publishing == 0 && removed) {
+    std::vector<std::pair<int, Callback>> remaining;
+    for (auto& callback : callbacks) {
+      if (callback.second)
+        remaining.push_back(callback);
+    }
+    callbacks.swap(remaining);
+    removed = false;
+  }
+}
+
+template <typename T> inline RingBuffer<T>::RingBuffer(size_t capacity) :
+  data(capacity), start(0), count(0) {
+}
+
+template <typename T> inline void RingBuffer<T>::push_back(const T& value) {
+  data[(start + count) % data.size()] = value;
+  if (count < data.size())
+    count++;
+  else
+    start = (start + 1) % data.size();
+}
+
+template <typename T> inline void RingBuffer<T>::pop_front() {
+  start = (start + 1) % data.size();
+  count--;
+}
+
+template <typename T> inline void RingBuffer<T>::pop_back() {
+  count--;
+}
+
+template <typename T> inline const T& RingBuffer<T>::front() const {
+  return data[start];
+}
+
+template <typename T> inline const T& RingBuffer<T>::back() const {
+  return data[(start + count - 1) % data.size()];
+}
+
+template <typename T> inline size_t RingBuffer<T>::size() const {
+  return count;
+}
+
+template <typename T> inline bool RingBuffer<T>::empty() const {
+  return count == 0;
+}
+
+template <typename T> inline bool RingBuffer<T>::full() const {
+  return count == data.size();
+}
+
+template <typename S, typename F>
+inline Derived<typename std::decay<decltype(std::declval<F>()(
+  std::declval<const typename DerivedSource<S>::Value&>()))>::type>
+map(const S& source, F function) {
+  typedef typename DerivedSource<S>::Value Input;
+  typedef typename std::decay<decltype(function(std::declval<const Input&>()))>::type Output;
+  return Derived<Output>::create(source, [function] (const Input& input, Output& output) {
+    output = function(input);
+    return true;
+  });
+}
+
+template <typename S>
+inline Derived<WindowStats<typename DerivedSource<S>::Value>> window(const S& source,
+                                                                     size_t size) {
+  typedef typename DerivedSource<S>::Value Input;
+  static_assert(std::is_arithmetic<Input>::value, "Windows require a numeric stream");
+  if (size == 0)
+    throw std::invalid_argument("Window size must be at least 1");
+  struct State {
+    explicit State(size_t size) : values(size), minima(size), maxima(size), index(0), sum(0) {}
+    RingBuffer<Input> values;
+    /** Candidates for the minimum and maximum, with their indices, in order */
+    RingBuffer<std::pair<google::protobuf::uint64, Input>> minima;
+    RingBuffer<std::pair<google::protobuf::uint64, Input>> maxima;
+    google::protobuf::uint64 index;
+    double sum;
+  };
+  std::shared_ptr<State> state = std::make_shared<State>(size);
+  return Derived<WindowStats<Input>>::create(
+    source, [state, size] (const Input& input, WindowStats<Input>& output) {
+      State& s = *state;
+      if (s.values.full())
+        s.sum -= s.values.front();
+      s.values.push_back(input);
+      s.sum += input;
+      // Values that are superseded by the new value can never be the minimum or maximum
+      while (!s.minima.empty() && !(s.minima.back().second < input))
+        s.minima.pop_back();
+      s.minima.push_back(std::make_pair(s.index, input));
+      while (!s.maxima.empty() && !(input < s.maxima.back().second))
+        s.maxima.pop_back();
+      s.maxima.push_back(std::make_pair(s.index, input));
+      if (s.index >= size) {
+        google::protobuf::uint64 oldest = s.index - size + 1;
+        if (s.minima.front().first < oldest)
+          s.minima.pop_front();
+        if (s.maxima.front().first < oldest)
+          s.maxima.pop_front();
+      }
+      s.index++;
+      output.min = s.minima.front().second;
+      output.max = s.maxima.front().second;
+      output.count = s.values.size();
+      output.mean = s.sum / output.count;
+      return true;
+    });
+}
+
+template <typename S>
+inline Derived<double> derivative(const S& source, const std::function<double()>& clock) {
+  typedef typename DerivedSource<S>::Value Input;
+  static_assert(std::is_arithmetic<Input>::value, "Derivatives require a numeric stream");
+  std::function<double()> now = clock;
+  if (!now) {
+    now = [] {
+      return std::chrono::duration<double>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    };
+  }
+  struct State {
+    bool started;
+    double time;
+    double value;
+  };
+  std::shared_ptr<State> state = std::make_shared<State>(State{false, 0, 0});
+  return Derived<double>::create(source, [state, now] (const Input& input, double& output) {
+    double time = now();
+    double value = static_cast<double>(input);
+    bool started = state->started;
+    double elapsed = time - state->time;
+    double change = value - state->value;
+    if (started && elapsed <= 0)
+      return false;
+    *state = State{true, time, value};
+    if (!started)
+      return false;
+    output = change / elapsed;
+    return true;
+  });
+}
+
+template <typename S>
+inline Derived<double> ema(const S& source, double alpha) {
+  typedef typename DerivedSource<S>::Value Input;
+  static_assert(std::is_arithmetic<Input>::value, "Moving averages require a numeric stream");
+  if (alpha <= 0 || alpha > 1)
+    throw std::invalid_argument("Moving average alpha must be between 0 and 1");
+  std::shared_ptr<bool> started = std::make_shared<bool>(false);
+  return Derived<double>::create(source, [started, alpha] (const Input& input, double& output) {
+    double value = static_cast<double>(input);
+    if (*started) {
+      output += alpha * (value - output);
+    } else {
+      output = value;
+      *started = true;
+    }
+    return true;
+  });
+}
+
+template <typename S>
+inline Derived<typename DerivedSource<S>::Value> throttle(const S& source, double interval) {
+  typedef typename DerivedSource<S>::Value Input;
+  typedef std::chrono::steady_clock Clock;
+  Clock::duration period = std::chrono::duration_cast<Clock::duration>(
+    std::chrono::duration<double>(interval));
+  std::shared_ptr<Clock::time_point> next = std::make_shared<Clock::time_point>();
+  return Derived<Input>::create(source, [next, period] (const Input& input, Input& output) {
+    Clock::time_point now = Clock::now();
+    if (now < *next)
+      return false;
+    *next = now + period;
+    output = input;
+    return true;
+  });
+}
+
+}  // namespace krpc
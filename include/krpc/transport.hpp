@@ -0,0 +1,586 @@
+#pragma once
+
+#include <google/protobuf/stubs/port.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>  // NOLINT(build/c++11)
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>  // NOLINT(build/c++11)
+#include <new>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#ifndef ASIO_STANDALONE
+#define ASIO_STANDALONE
+#endif
+#include <asio/connect.hpp>
+#include <asio/io_service.hpp>
+#include <asio/ip/tcp.hpp>
+#include <asio/read.hpp>
+#include <asio/write.hpp>
+#ifdef ASIO_HAS_LOCAL_SOCKETS
+#include <asio/local/stream_protocol.hpp>
+#endif
+
+#include "krpc/client.hpp"
+#include "krpc/connection.hpp"
+#include "krpc/error.hpp"
+#include "krpc/handshake.hpp"
+#include "krpc/krpc.pb.hpp"
+#include "krpc/mapped_file.hpp"
+
+namespace krpc {
+
+/** A transport over a stream socket of the given asio protocol. */
+template <typename Protocol>
+class SocketTransport : public Transport {
+ public:
+  typedef typename Protocol::socket Socket;
+  /** Wrap a connected socket. */
+  SocketTransport(std::unique_ptr<asio::io_service> io_service, std::unique_ptr<Socket> socket);
+  void send(const char* header, size_t header_length, const char* data, size_t length);
+  void receive(char* data, size_t length);
+  void close();
+
+ protected:
+  std::unique_ptr<asio::io_service> io_service;
+  std::unique_ptr<Socket> socket;
+};
+
+/** A transport over TCP, the transport used by the kRPC server. */
+class TcpTransport : public SocketTransport<asio::ip::tcp> {
+ public:
+  TcpTransport(const std::string& address, unsigned int port,
+               const ConnectionOptions& options = ConnectionOptions());
+  /** Wrap a connected socket. */
+  TcpTransport(std::unique_ptr<asio::io_service> io_service, std::unique_ptr<Socket> socket);
+};
+
+#ifdef ASIO_HAS_LOCAL_SOCKETS
+/**
+ * A transport over a Unix domain socket, which avoids the TCP/IP stack when the client and
+ * server are on the same host.
+ */
+class UnixTransport : public SocketTransport<asio::local::stream_protocol> {
+ public:
+  explicit UnixTransport(const std::string& path);
+  /** Wrap a connected socket. */
+  UnixTransport(std::unique_ptr<asio::io_service> io_service, std::unique_ptr<Socket> socket);
+};
+#endif
+
+/**
+ * A transport through a pair of ring buffers in a memory mapped file, shared by a client
+ * and server on the same host, so that messages are exchanged without system calls. On
+ * Linux, put the file in /dev/shm so that it is not written to disk. Each side busy waits
+ * for data briefly, then yields its time slice, so the rings suit latency sensitive loops
+ * rather than idle connections. A file is used by one client and one server at a time.
+ */
+class SharedMemoryTransport : public Transport {
+ public:
+  /** Create the file for a connection, with rings of the given capacity, as the server. */
+  SharedMemoryTransport(const std::string& path, size_t capacity);
+  /** Connect to the server that created the file, as the client. */
+  explicit SharedMemoryTransport(const std::string& path);
+  ~SharedMemoryTransport();
+  /** Whether a client has connected. Called by the server. */
+  bool connected() const;
+  void send(const char* header, size_t header_length, const char* data, size_t length);
+  void receive(char* data, size_t length);
+  void close();
+
+ private:
+  SharedMemoryTransport(const SharedMemoryTransport&) = delete;
+  SharedMemoryTransport& operator=(const SharedMemoryTransport&) = delete;
+  struct Ring {
+    /** Read position, written by the consumer */
+    alignas(64) std::atomic<google::protobuf::uint64> head;
+    /** Write position, written by the producer */
+    alignas(64) std::atomic<google::protobuf::uint64> tail;
+  };
+  struct Header {
+    char magic[8];
+    google::protobuf::uint64 capacity;
+    std::atomic<google::protobuf::uint32> connected;
+    std::atomic<google::protobuf::uint32> closed;
+    /** From the client to the server, then from the server to the client */
+    Ring rings[2];
+  };
+  /** Wait for a ring, yielding after a number of attempts. Throws if closed. */
+  void wait(unsigned int& attempts) const;
+  void write(const char* data, size_t length);
+  MappedFile file;
+  Header* header;
+  char* buffers[2];
+  google::protobuf::uint64 capacity;
+  /** The ring this side writes to */
+  int out;
+};
+
+/** Accepts connections from clients, for a server. */
+class TransportListener {
+ public:
+  virtual ~TransportListener() {}
+  /** Wait up to the given time for a client. Returns nullptr if none connected. */
+  virtual std::shared_ptr<Transport> accept(std::chrono::milliseconds timeout) = 0;
+};
+
+class TcpListener : public TransportListener {
+ public:
+  /** Listen on an address and port. If port is zero, a free port is chosen. */
+  TcpListener(const std::string& address, unsigned int port);
+  unsigned int port() const;
+  std::shared_ptr<Transport> accept(std::chrono::milliseconds timeout);
+
+ private:
+  asio::io_service io_service;
+  asio::ip::tcp::acceptor acceptor;
+};
+
+#ifdef ASIO_HAS_LOCAL_SOCKETS
+class UnixListener : public TransportListener {
+ public:
+  /** Listen on a path, replacing any file at that path. */
+  explicit UnixListener(const std::string& path);
+  ~UnixListener();
+  std::shared_ptr<Transport> accept(std::chrono::milliseconds timeout);
+
+ private:
+  std::string path;
+  asio::io_service io_service;
+  asio::local::stream_protocol::acceptor acceptor;
+};
+#endif
+
+/**
+ * Accepts clients through a shared memory file, one at a time. Once a client connects, the
+ * file is removed and created again for the next one, and the connected client keeps the
+ * memory it mapped. Windows does not allow a mapped file to be removed, so there the
+ * listener fails to accept a second client while the first is connected.
+ */
+class SharedMemoryListener : public TransportListener {
+ public:
+  SharedMemoryListener(const std::string& path, size_t capacity = 1 << 20);
+  std::shared_ptr<Transport> accept(std::chrono::milliseconds timeout);
+
+ private:
+  std::string path;
+  size_t capacity;
+  std::shared_ptr<SharedMemoryTransport> pending;
+};
+
+/**
+ * Connect to a server given an address of the form host:port for TCP, unix:path for a
+ * Unix domain socket, or shm:path for shared memory.
+ */
+std::shared_ptr<Transport> connect_transport(const std::string& address);
+
+/**
+ * Connect to a server through a transport, as a client with the given name. The client's
+ * generated services make their calls through the transport, as described for
+ * Client::use_transport(). The client has no stream connection, so it can't use streams.
+ */
+Client connect(const std::shared_ptr<Transport>& transport, const std::string& name = "");
+
+/**
+ * A server that speaks the kRPC protocol through any transport, for testing clients of the
+ * Unix socket and shared memory transports, which the kRPC server does not provide. Each
+ * request is answered by the handler on a thread per connection.
+ */
+class LocalServer {
+ public:
+  /** Handles a request. Returns false if it cannot, in which case the server returns an error. */
+  typedef std::function<bool(const schema::Request&, schema::Response&)> Handler;
+  LocalServer(std::unique_ptr<TransportListener> listener, const Handler& handler);
+  ~LocalServer();
+
+ private:
+  LocalServer(const LocalServer&) = delete;
+  LocalServer& operator=(const LocalServer&) = delete;
+  void accept();
+  void serve(const std::shared_ptr<Transport>& transport);
+  std::unique_ptr<TransportListener> listener;
+  Handler handler;
+  std::atomic<bool> stopped;
+  std::mutex lock;
+  std::vector<std::shared_ptr<Transport>> transports;
+  std::vector<std::thread> threads;
+  std::thread thread;
+};
+
+template <typename Protocol> inline SocketTransport<Protocol>::SocketTransport(
+  std::unique_ptr<asio::io_service> io_service, std::unique_ptr<Socket> socket) :
+  io_service(std::move(io_service)), socket(std::move(socket)) {
+}
+
+template <typename Protocol> inline void SocketTransport<Protocol>::send(
+  const char* header, size_t header_length, const char* data, size_t length) {
+  std::array<asio::const_buffer, 2> buffers = {{
+    asio::buffer(header, header_length), asio::buffer(data, length)}};
+  asio::error_code error;
+  asio::write(*socket, buffers, error);
+  if (error)
+    throw ConnectionError(error.message());
+}
+
+template <typename Protocol> inline void SocketTransport<Protocol>::receive(char* data,
+                                                                           size_t length) {
+  asio::error_code error;
+  asio::read(*socket, asio::buffer(data, length), error);
+  if (error)
+    throw ConnectionError(error.message());
+}
+
+template <typename Protocol> inline void SocketTransport<Protocol>::close() {
+  // Shutting down, rather than closing, the socket interrupts a blocked receive
+  asio::error_code error;
+  socket->shutdown(asio::socket_base::shutdown_both, error);
+}
+
+inline TcpTransport::TcpTransport(const std::string& address, unsigned int port,
+                                  const ConnectionOptions& options) :
+  SocketTransport(std::unique_ptr<asio::io_service>(new asio::io_service), nullptr) {
+  socket.reset(new Socket(*io_service));
+  asio::ip::tcp::resolver resolver(*io_service);
+  asio::error_code error;
+  auto endpoints = resolver.resolve(
+    asio::ip::tcp::resolver::query(address, std::to_string(port)), error);
+  if (!error)
+    asio::connect(*socket, endpoints, error);
+  if (error)
+    throw ConnectionError("Failed to connect to " + address + ":" + std::to_string(port) +
+                          ": " + error.message());
+  set_socket_options(*socket, options);
+}
+
+inline TcpTransport::TcpTransport(std::unique_ptr<asio::io_service> io_service,
+                                  std::unique_ptr<Socket> socket) :
+  SocketTransport(std::move(io_service), std::move(socket)) {
+  set_socket_options(*this->socket, ConnectionOptions());
+}
+
+#ifdef ASIO_HAS_LOCAL_SOCKETS
+
+inline UnixTransport::UnixTransport(const std::string& path) :
+  SocketTransport(std::unique_ptr<asio::io_service>(new asio::io_service), nullptr) {
+  socket.reset(new Socket(*io_service));
+  asio::error_code error;
+  socket->connect(asio::local::stream_protocol::endpoint(path), error);
+  if (error)
+    throw ConnectionError("Failed to connect to " + path + ": " + error.message());
+}
+
+inline UnixTransport::UnixTransport(std::unique_ptr<asio::io_service> io_service,
+                                    std::unique_ptr<Socket> socket) :
+  SocketTransport(std::move(io_service), std::move(socket)) {
+}
+
+#endif
+
+inline SharedMemoryTransport::SharedMemoryTransport(const std::string& path, size_t capacity) :
+  file(path, sizeof(Header) + 2 * capacity), capacity(capacity), out(1) {
+  if (capacity == 0)
+    throw std::invalid_argument("Shared memory capacity must be at least 1");
+  header = new (file.data()) Header;
+  header->capacity = capacity;
+  header->connected = 0;
+  header->closed = 0;
+  for (auto& ring : header->rings) {
+    ring.head = 0;
+    ring.tail = 0;
+  }
+  buffers[0] = file.data() + sizeof(Header);
+  buffers[1] = buffers[0] + capacity;
+  // Written last, so a client never sees a partly initialized header
+  std::atomic_thread_fence(std::memory_order_release);
+  std::memcpy(header->magic, "KRPCSHM1", 8);
+}
+
+inline SharedMemoryTransport::SharedMemoryTransport(const std::string& path) :
+  file(path), out(0) {
+  header = reinterpret_cast<Header*>(file.data());
+  if (file.size() < sizeof(Header) || std::memcmp(header->magic, "KRPCSHM1", 8) != 0)
+    throw ConnectionError("Not a shared memory connection: " + path);
+  std::atomic_thread_fence(std::memory_order_acquire);
+  capacity = header->capacity;
+  if (file.size() < sizeof(Header) + 2 * capacity)
+    throw ConnectionError("Not a shared memory connection: " + path);
+  buffers[0] = file.data() + sizeof(Header);
+  buffers[1] = buffers[0] + capacity;
+  if (header->connected.exchange(1) != 0)
+    throw ConnectionError("Shared memory connection is already in use: " + path);
+}
+
+inline SharedMemoryTransport::~SharedMemoryTransport() {
+  close();
+}
+
+inline bool SharedMemoryTransport::connected() const {
+  return header->connected.load(std::memory_order_acquire) != 0;
+}
+
+inline void SharedMemoryTransport::send(const char* header, size_t header_length,
+                                        const char* data, size_t length) {
+  write(header, header_length);
+  write(data, length);
+}
+
+inline void SharedMemoryTransport::write(const char* data, size_t length) {
+  Ring& ring = header->rings[out];
+  char* buffer = buffers[out];
+  google::protobuf::uint64 tail = ring.tail.load(std::memory_order_relaxed);
+  unsigned int attempts = 0;
+  while (length > 0) {
+    size_t space = static_cast<size_t>(
+      capacity - (tail - ring.head.load(std::memory_order_acquire)));
+    if (space == 0) {
+      wait(attempts);
+      continue;
+    }
+    // Copy up to the end of the buffer, then wrap around
+    size_t offset = static_cast<size_t>(tail % capacity);
+    size_t size = std::min(std::min(space, length), static_cast<size_t>(capacity) - offset);
+    std::memcpy(buffer + offset, data, size);
+    tail += size;
+    ring.tail.store(tail, std::memory_order_release);
+    data += size;
+    length -= size;
+    attempts = 0;
+  }
+}
+
+inline void SharedMemoryTransport::receive(char* data, size_t length) {
+  Ring& ring = header->rings[1 - out];
+  const char* buffer = buffers[1 - out];
+  google::protobuf::uint64 head = ring.head.load(std::memory_order_relaxed);
+  unsigned int attempts = 0;
+  while (length > 0) {
+    size_t available = static_cast<size_t>(ring.tail.load(std::memory_order_acquire) - head);
+    if (available == 0) {
+      wait(attempts);
+      continue;
+    }
+    size_t offset = static_cast<size_t>(head % capacity);
+    size_t size = std::min(std::min(available, length), static_cast<size_t>(capacity) - offset);
+    std::memcpy(data, buffer + offset, size);
+    head += size;
+    ring.head.store(head, std::memory_order_release);
+    data += size;
+    length -= size;
+    attempts = 0;
+  }
+}
+
+inline void SharedMemoryTransport::wait(unsigned int& attempts) const {
+  if (header->closed.load(std::memory_order_acquire))
+    throw ConnectionError("Shared memory connection closed");
+  // Spinning only helps if the other side is running on another processor
+  static const bool spin = std::thread::hardware_concurrency() > 1;
+  attempts++;
+  if (attempts > 4096)
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  else if (!spin || attempts > 1024)
+    std::this_thread::yield();
+}
+
+inline void SharedMemoryTransport::close() {
+  header->closed.store(1, std::memory_order_release);
+}
+
+inline TcpListener::TcpListener(const std::string& address, unsigned int port) :
+  acceptor(io_service, asio::ip::tcp::endpoint(asio::ip::address::from_string(address), port)) {
+  acceptor.non_blocking(true);
+}
+
+inline unsigned int TcpListener::port() const {
+  return acceptor.local_endpoint().port();
+}
+
+inline std::shared_ptr<Transport> TcpListener::accept(std::chrono::milliseconds timeout) {
+  auto deadline = std::chrono::steady_clock::now() + timeout;
+  std::unique_ptr<asio::io_service> service(new asio::io_service);
+  std::unique_ptr<asio::ip::tcp::socket> socket(new asio::ip::tcp::socket(*service));
+  while (true) {
+    asio::error_code error;
+    acceptor.accept(*socket, error);
+    if (!error)
+      return std::make_shared<TcpTransport>(std::move(service), std::move(socket));
+    if (error != asio::error::would_block && error != asio::error::try_again)
+      throw ConnectionError("Failed to accept connection: " + error.message());
+    if (std::chrono::steady_clock::now() >= deadline)
+      return nullptr;
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+}
+
+#ifdef ASIO_HAS_LOCAL_SOCKETS
+
+inline UnixListener::UnixListener(const std::string& path) :
+  path(path), acceptor(io_service) {
+  std::remove(path.c_str());
+  asio::local::stream_protocol::endpoint endpoint(path);
+  acceptor.open(endpoint.protocol());
+  acceptor.bind(endpoint);
+  acceptor.listen();
+  acceptor.non_blocking(true);
+}
+
+inline UnixListener::~UnixListener() {
+  asio::error_code error;
+  acceptor.close(error);
+  std::remove(path.c_str());
+}
+
+inline std::shared_ptr<Transport> UnixListener::accept(std::chrono::milliseconds timeout) {
+  auto deadline = std::chrono::steady_clock::now() + timeout;
+  std::unique_ptr<asio::io_service> service(new asio::io_service);
+  std::unique_ptr<asio::local::stream_protocol::socket> socket(
+    new asio::local::stream_protocol::socket(*service));
+  while (true) {
+    asio::error_code error;
+    acceptor.accept(*socket, error);
+    if (!error)
+      return std::make_shared<UnixTransport>(std::move(service), std::move(socket));
+    if (error != asio::error::would_block && error != asio::error::try_again)
+      throw ConnectionError("Failed to accept connection: " + error.message());
+    if (std::chrono::steady_clock::now() >= deadline)
+      return nullptr;
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+}
+
+#endif
+
+inline SharedMemoryListener::SharedMemoryListener(const std::string& path, size_t capacity) :
+  path(path), capacity(capacity) {
+  std::remove(path.c_str());
+  pending.reset(new SharedMemoryTransport(path, capacity));
+}
+
+inline std::shared_ptr<Transport> SharedMemoryListener::accept(
+  std::chrono::milliseconds timeout) {
+  auto deadline = std::chrono::steady_clock::now() + timeout;
+  if (!pending) {
+    std::remove(path.c_str());
+    pending.reset(new SharedMemoryTransport(path, capacity));
+  }
+  while (!pending->connected()) {
+    if (std::chrono::steady_clock::now() >= deadline)
+      return nullptr;
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  std::shared_ptr<Transport> result = pending;
+  pending.reset();
+  return result;
+}
+
+inline std::shared_ptr<Transport> connect_transport(const std::string& address) {
+  if (address.compare(0, 4, "shm:") == 0)
+    return std::make_shared<SharedMemoryTransport>(address.substr(4));
+  if (address.compare(0, 5, "unix:") == 0) {
+#ifdef ASIO_HAS_LOCAL_SOCKETS
+    return std::make_shared<UnixTransport>(address.substr(5));
+#else
+    throw ConnectionError("Unix domain sockets are not supported on this platform");
+#endif
+  }
+  size_t colon = address.rfind(':');
+  if (colon == std::string::npos)
+    throw std::invalid_argument("Invalid address " + address);
+  return std::make_shared<TcpTransport>(
+    address.substr(0, colon), static_cast<unsigned int>(std::stoul(address.substr(colon + 1))));
+}
+
+inline Client connect(const std::shared_ptr<Transport>& transport, const std::string& name) {
+  schema::ConnectionRequest request;
+  request.set_type(schema::ConnectionRequest::RPC);
+  request.set_client_name(name);
+  std::string buffer;
+  transport->send_message(request, buffer);
+  transport->receive_message(buffer);
+  schema::ConnectionResponse response;
+  if (!response.ParseFromString(buffer))
+    throw EncodingError("Failed to decode connection response");
+  if (response.status() != schema::ConnectionResponse::OK)
+    throw ConnectionError(response.message());
+  Client client;
+  client.use_transport(transport);
+  return client;
+}
+
+inline LocalServer::LocalServer(std::unique_ptr<TransportListener> listener,
+                                const Handler& handler) :
+  listener(std::move(listener)), handler(handler), stopped(false) {
+  thread = std::thread(&LocalServer::accept, this);
+}
+
+inline LocalServer::~LocalServer() {
+  stopped = true;
+  thread.join();
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    for (auto& transport : transports)
+      transport->close();
+  }
+  for (auto& connection : threads)
+    connection.join();
+}
+
+inline void LocalServer::accept() {
+  while (!stopped) {
+    std::shared_ptr<Transport> transport;
+    try {
+      transport = listener->accept(std::chrono::milliseconds(10));
+    } catch (const ConnectionError&) {
+      continue;
+    }
+    if (!transport)
+      continue;
+    std::lock_guard<std::mutex> guard(lock);
+    transports.push_back(transport);
+    threads.push_back(std::thread(&LocalServer::serve, this, transport));
+  }
+}
+
+inline void LocalServer::serve(const std::shared_ptr<Transport>& transport) {
+  std::string buffer;
+  try {
+    transport->receive_message(buffer);
+    schema::ConnectionResponse connection_response =
+      answer_connection_request(buffer, schema::ConnectionRequest::RPC);
+    transport->send_message(connection_response, buffer);
+    if (connection_response.status() != schema::ConnectionResponse::OK)
+      return;
+    schema::Request request;
+    schema::Response response;
+    while (true) {
+      transport->receive_message(buffer);
+      response.Clear();
+      std::string error = "The request was not handled";
+      bool handled = false;
+      try {
+        handled = request.ParseFromString(buffer) && handler(request, response);
+      } catch (const std::exception& e) {
+        error = e.what();
+      }
+      if (!handled) {
+        response.Clear();
+        response.mutable_error()->set_description(error);
+      }
+      transport->send_message(response, buffer);
+    }
+  } catch (const std::exception&) {
+  }
+  // The client disconnected, sent an invalid message, or the server is being destroyed
+  transport->close();
+}
+
+}  // namespace krpc
@@ -0,0 +1,194 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>  // NOLINT(build/c++11)
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "krpc/client.hpp"
+#include "krpc/connection.hpp"
+#include "krpc/decoder.hpp"
+#include "krpc/encoder.hpp"
+#include "krpc/error.hpp"
+#include "krpc/krpc.pb.hpp"
+#include "krpc/message_parser.hpp"
+#include "krpc/services/space_center.hpp"
+
+namespace krpc {
+
+/**
+ * The state of a vessel at one instant. Vectors and rotations are in the reference
+ * frame passed to VesselSnapshot, and flight values are relative to it.
+ */
+struct VesselState {
+  /** Universal time, in seconds */
+  double ut;
+  double position[3];
+  double velocity[3];
+  /** Rotation as a quaternion (x, y, z, w) */
+  double rotation[4];
+  double direction[3];
+  double angular_velocity[3];
+  double mass;
+  double dry_mass;
+  double thrust;
+  double available_thrust;
+  double specific_impulse;
+  double mean_altitude;
+  double surface_altitude;
+  double speed;
+  double horizontal_speed;
+  double vertical_speed;
+  double g_force;
+  double dynamic_pressure;
+  double pitch;
+  double heading;
+  double roll;
+  double angle_of_attack;
+  double apoapsis_altitude;
+  double periapsis_altitude;
+  double time_to_apoapsis;
+  double time_to_periapsis;
+  double eccentricity;
+  double inclination;
+  double period;
+};
+
+/**
+ * Reads the state of a vessel using a single request. The calls are encoded once, when
+ * the snapshot is created, and the server evaluates all of them while processing the
+ * request, so the values normally come from the same physics tick.
+ */
+class VesselSnapshot {
+ public:
+  VesselSnapshot(Client * client, const services::SpaceCenter::Vessel& vessel,
+                 const services::SpaceCenter::ReferenceFrame& reference_frame);
+  /** Read the state of the vessel. Throws if any of the calls fail. */
+  void read(VesselState& state);
+  VesselState read();
+
+ private:
+  typedef void (*Setter)(const std::string& data, VesselState& state);
+  template <double VesselState::*Field, typename T>
+  static void set(const std::string& data, VesselState& state);
+  template <double (VesselState::*Field)[3]>
+  static void set_vector(const std::string& data, VesselState& state);
+  template <double (VesselState::*Field)[4]>
+  static void set_quaternion(const std::string& data, VesselState& state);
+  void add(const schema::ProcedureCall& call, Setter setter);
+  Client * client;
+  /** The calls, in the same order as their setters */
+  schema::Request calls;
+  /** The request, encoded with its size */
+  std::string request;
+  /** The last response received, whose capacity is reused */
+  std::string received;
+  std::vector<Setter> setters;
+  std::unique_ptr<MessageParser<schema::Response>> responses;
+};
+
+inline VesselSnapshot::VesselSnapshot(
+  Client * client, const services::SpaceCenter::Vessel& vessel,
+  const services::SpaceCenter::ReferenceFrame& reference_frame) :
+  client(client), responses(new MessageParser<schema::Response>()) {
+  typedef services::SpaceCenter::Vessel Vessel;
+  typedef services::SpaceCenter::Flight Flight;
+  typedef services::SpaceCenter::Orbit Orbit;
+  services::SpaceCenter space_center(client);
+  Vessel target = vessel;
+  Flight flight = target.flight(reference_frame);
+  Orbit orbit = target.orbit();
+  add(space_center.ut_call(), &set<&VesselState::ut, double>);
+  add(target.position_call(reference_frame), &set_vector<&VesselState::position>);
+  add(target.velocity_call(reference_frame), &set_vector<&VesselState::velocity>);
+  add(target.rotation_call(reference_frame), &set_quaternion<&VesselState::rotation>);
+  add(target.direction_call(reference_frame), &set_vector<&VesselState::direction>);
+  add(target.angular_velocity_call(reference_frame),
+      &set_vector<&VesselState::angular_velocity>);
+  add(target.mass_call(), &set<&VesselState::mass, float>);
+  add(target.dry_mass_call(), &set<&VesselState::dry_mass, float>);
+  add(target.thrust_call(), &set<&VesselState::thrust, float>);
+  add(target.available_thrust_call(), &set<&VesselState::available_thrust, float>);
+  add(target.specific_impulse_call(), &set<&VesselState::specific_impulse, float>);
+  add(flight.mean_altitude_call(), &set<&VesselState::mean_altitude, double>);
+  add(flight.surface_altitude_call(), &set<&VesselState::surface_altitude, double>);
+  add(flight.speed_call(), &set<&VesselState::speed, double>);
+  add(flight.horizontal_speed_call(), &set<&VesselState::horizontal_speed, double>);
+  add(flight.vertical_speed_call(), &set<&VesselState::vertical_speed, double>);
+  add(flight.g_force_call(), &set<&VesselState::g_force, float>);
+  add(flight.dynamic_pressure_call(), &set<&VesselState::dynamic_pressure, float>);
+  add(flight.pitch_call(), &set<&VesselState::pitch, float>);
+  add(flight.heading_call(), &set<&VesselState::heading, float>);
+  add(flight.roll_call(), &set<&VesselState::roll, float>);
+  add(flight.angle_of_attack_call(), &set<&VesselState::angle_of_attack, float>);
+  add(orbit.apoapsis_altitude_call(), &set<&VesselState::apoapsis_altitude, double>);
+  add(orbit.periapsis_altitude_call(), &set<&VesselState::periapsis_altitude, double>);
+  add(orbit.time_to_apoapsis_call(), &set<&VesselState::time_to_apoapsis, double>);
+  add(orbit.time_to_periapsis_call(), &set<&VesselState::time_to_periapsis, double>);
+  add(orbit.eccentricity_call(), &set<&VesselState::eccentricity, double>);
+  add(orbit.inclination_call(), &set<&VesselState::inclination, double>);
+  add(orbit.period_call(), &set<&VesselState::period, double>);
+  request = encoder::encode_message_with_size(calls);
+}
+
+inline void VesselSnapshot::read(VesselState& state) {
+  {
+    std::lock_guard<std::mutex> guard(*client->lock);
+    client->rpc_connection->send(request);
+    client->rpc_connection->receive_message(received);
+  }
+  const schema::Response& response = responses->parse(received);
+  if (response.has_error())
+    client->throw_exception(response.error());
+  if (response.results_size() != static_cast<int>(setters.size()))
+    throw RPCError("Snapshot request returned an unexpected number of results");
+  for (size_t i = 0; i < setters.size(); i++) {
+    const schema::ProcedureResult& result = response.results(static_cast<int>(i));
+    if (result.has_error())
+      client->throw_exception(result.error());
+    setters[i](result.value(), state);
+  }
+}
+
+inline VesselState VesselSnapshot::read() {
+  VesselState state;
+  read(state);
+  return state;
+}
+
+template <double VesselState::*Field, typename T>
+inline void VesselSnapshot::set(const std::string& data, VesselState& state) {
+  T value;
+  decoder::decode(value, data.data(), data.size());
+  state.*Field = value;
+}
+
+template <double (VesselState::*Field)[3]>
+inline void VesselSnapshot::set_vector(const std::string& data, VesselState& state) {
+  std::tuple<double, double, double> value;
+  decoder::decode(value, data.data(), data.size());
+  double * vector = state.*Field;
+  vector[0] = std::get<0>(value);
+  vector[1] = std::get<1>(value);
+  vector[2] = std::get<2>(value);
+}
+
+template <double (VesselState::*Field)[4]>
+inline void VesselSnapshot::set_quaternion(const std::string& data, VesselState& state) {
+  std::tuple<double, double, double, double> value;
+  decoder::decode(value, data.data(), data.size());
+  double * quaternion = state.*Field;
+  quaternion[0] = std::get<0>(value);
+  quaternion[1] = std::get<1>(value);
+  quaternion[2] = std::get<2>(value);
+  quaternion[3] = std::get<3>(value);
+}
+
+inline void VesselSnapshot::add(const schema::ProcedureCall& call, Setter setter) {
+  *calls.add_calls() = call;
+  setters.push_back(setter);
+}
+
+}  // namespace krpc